@@ -0,0 +1,122 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Incremental match statistics
+ * ----------------------------------------------------------------------------
+ */
+
+#include <math.h>
+#include <string.h>
+#include "analytics.h"
+#include "engine.h"
+
+_Static_assert((ANALYTICS_RECENT_ROUNDS & (ANALYTICS_RECENT_ROUNDS - 1)) == 0,
+               "ANALYTICS_RECENT_ROUNDS must be a power of two");
+
+/* --- View arithmetic --- */
+static inline void view_add(AnalyticsView *v, int player, int computer, int result) {
+    v->rounds++;
+    v->results[result]++;
+    v->player_moves[player - 1]++;
+    v->computer_moves[computer - 1]++;
+}
+
+static inline void view_remove(AnalyticsView *v, int player, int computer, int result) {
+    v->rounds--;
+    v->results[result]--;
+    v->player_moves[player - 1]--;
+    v->computer_moves[computer - 1]--;
+}
+
+static void view_subtract(AnalyticsView *v, const AnalyticsView *part) {
+    v->rounds -= part->rounds;
+    for (int i = 0; i < 3; i++) v->results[i] -= part->results[i];
+    for (int i = 0; i < RULES_MAX_MOVES; i++) {
+        v->player_moves[i] -= part->player_moves[i];
+        v->computer_moves[i] -= part->computer_moves[i];
+    }
+}
+
+void analytics_init(Analytics *a) {
+    memset(a, 0, sizeof(*a));
+}
+
+/* Rotate the hour ring up to `now_s`; each step clears (and un-counts) one
+ * bucket, and at most a full lap is ever needed, so this stays O(1) */
+void analytics_advance(Analytics *a, uint64_t now_s) {
+    uint64_t minute = now_s / ANALYTICS_BUCKET_SECONDS;
+    uint64_t steps;
+
+    if (a->hour.rounds == 0) {
+        a->bucket_minute = minute; /* nothing to expire; just re-anchor */
+        return;
+    }
+    if (minute <= a->bucket_minute) return;
+    steps = minute - a->bucket_minute;
+    if (steps > ANALYTICS_HOUR_BUCKETS) steps = ANALYTICS_HOUR_BUCKETS;
+    for (uint64_t i = 1; i <= steps; i++) {
+        AnalyticsView *b = &a->buckets[(a->bucket_minute + i) % ANALYTICS_HOUR_BUCKETS];
+        view_subtract(&a->hour, b);
+        memset(b, 0, sizeof(*b));
+    }
+    a->bucket_minute = minute;
+}
+
+void analytics_record_round(Analytics *a, int player_choice, int computer_choice, int result, uint64_t now_s) {
+    uint64_t slot = a->total.rounds & (ANALYTICS_RECENT_ROUNDS - 1);
+
+    /* streaks */
+    if (a->total.rounds > 0 && a->streak_result == result) {
+        a->streak++;
+    } else {
+        a->streak = 1;
+        a->streak_result = (uint8_t)result;
+    }
+    if (a->streak > a->best_streak[result]) a->best_streak[result] = a->streak;
+
+    /* last N rounds: evict the round this slot held once the ring is full */
+    if (a->total.rounds >= ANALYTICS_RECENT_ROUNDS) {
+        uint8_t old = a->recent_ring[slot];
+        view_remove(&a->recent, rules_round_player(old), rules_round_computer(old), rules_round_result(old));
+    }
+    a->recent_ring[slot] = rules_pack_round(player_choice, computer_choice, result);
+    view_add(&a->recent, player_choice, computer_choice, result);
+
+    /* last hour */
+    analytics_advance(a, now_s);
+    view_add(&a->buckets[a->bucket_minute % ANALYTICS_HOUR_BUCKETS], player_choice, computer_choice, result);
+    view_add(&a->hour, player_choice, computer_choice, result);
+
+    view_add(&a->total, player_choice, computer_choice, result);
+}
+
+void analytics_record_match(Analytics *a, int winner) {
+    a->matches++;
+    a->match_results[winner]++;
+}
+
+/* --- Queries --- */
+double analytics_rate(const AnalyticsView *v, int result) {
+    return v->rounds ? (double)v->results[result] / (double)v->rounds : 0.0;
+}
+
+double analytics_uniformity(const uint64_t *counts, int n_moves, double *chi2) {
+    double n = 0.0, expected, x = 0.0, term = 1.0, p = 0.0;
+
+    for (int i = 0; i < n_moves; i++) n += (double)counts[i];
+    expected = n / n_moves;
+    if (n > 0) {
+        for (int i = 0; i < n_moves; i++) {
+            double d = (double)counts[i] - expected;
+            x += d * d / expected;
+        }
+    }
+    if (chi2) *chi2 = x;
+    /* chi-square survival function for an even k = n_moves - 1 degrees of
+     * freedom: e^(-x/2) * sum over i < k/2 of (x/2)^i / i! */
+    for (int i = 0; i < (n_moves - 1) / 2; i++) {
+        p += term;
+        term *= x / 2.0 / (i + 1);
+    }
+    return exp(-x / 2.0) * p;
+}
@@ -0,0 +1,63 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Incremental match statistics (GTK-free)
+ * ----------------------------------------------------------------------------
+ * NOTE: Every aggregate is a running counter, so analytics_record_round()
+ * is O(1) whatever the history length. Windowed views keep their own
+ * running sums: the last-N view subtracts the round falling out of its
+ * ring, the last-hour view rotates one-minute buckets and subtracts the
+ * bucket it clears. Reading a view is a struct copy.
+ */
+
+#ifndef RPS_ANALYTICS_H
+#define RPS_ANALYTICS_H
+
+#include <stdint.h>
+#include "rules.h"
+
+#define ANALYTICS_RECENT_ROUNDS 128   /* "last N rounds" window, power of two */
+#define ANALYTICS_HOUR_BUCKETS 60     /* one-minute buckets */
+#define ANALYTICS_BUCKET_SECONDS 60
+
+/* Counts over some span of rounds; moves are indexed by move - 1 */
+typedef struct {
+    uint64_t rounds;
+    uint64_t results[3];          /* RESULT_*, from the player's side */
+    uint64_t player_moves[RULES_MAX_MOVES];
+    uint64_t computer_moves[RULES_MAX_MOVES];
+} AnalyticsView;
+
+typedef struct {
+    AnalyticsView total;
+    uint64_t matches;
+    uint64_t match_results[3];    /* RESULT_* of whole matches */
+    uint32_t streak;              /* length of the current run of `streak_result` */
+    uint8_t streak_result;
+    uint32_t best_streak[3];      /* longest run per RESULT_* */
+
+    /* last ANALYTICS_RECENT_ROUNDS rounds, rules_pack_round() */
+    uint8_t recent_ring[ANALYTICS_RECENT_ROUNDS];
+    AnalyticsView recent;
+
+    /* last hour in rotating buckets; hour = sum of the live buckets */
+    AnalyticsView buckets[ANALYTICS_HOUR_BUCKETS];
+    uint64_t bucket_minute;       /* minute index the newest bucket covers */
+    AnalyticsView hour;
+} Analytics;
+
+void analytics_init(Analytics *a);
+/* now_s: any monotonic clock in seconds; only differences are used */
+void analytics_record_round(Analytics *a, int player_choice, int computer_choice, int result, uint64_t now_s);
+void analytics_record_match(Analytics *a, int winner);
+/* Expire last-hour buckets older than now_s without recording anything */
+void analytics_advance(Analytics *a, uint64_t now_s);
+
+/* Share of view rounds with `result`, 0 when empty */
+double analytics_rate(const AnalyticsView *v, int result);
+/* Pearson chi-square of n_moves move counts against uniform (n_moves - 1
+ * degrees of freedom, n_moves odd); returns the p-value, and the statistic
+ * through *chi2 if set */
+double analytics_uniformity(const uint64_t *counts, int n_moves, double *chi2);
+
+#endif /* RPS_ANALYTICS_H */
@@ -0,0 +1,34 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Shared benchmark helpers
+ * ----------------------------------------------------------------------------
+ */
+
+#ifndef RPS_BENCH_H
+#define RPS_BENCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/* Monotonic clock in nanoseconds */
+static inline uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* Keep the optimiser from discarding a computed value */
+static inline void bench_consume(uint64_t value) {
+    __asm__ __volatile__("" : : "r"(value) : "memory");
+}
+
+/* One JSON line per result, the format bench_compare reads: `better` is
+ * "lower" for costs (ns/round, ms) and "higher" for rates */
+static inline void bench_result(FILE *out, const char *name, double value, const char *unit, const char *better) {
+    fprintf(out, "{\"bench\":\"%s\",\"value\":%.6g,\"unit\":\"%s\",\"better\":\"%s\"}\n",
+            name, value, unit, better);
+}
+
+#endif /* RPS_BENCH_H */
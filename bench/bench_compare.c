@@ -0,0 +1,151 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Benchmark: compare suite results against a baseline
+ * ----------------------------------------------------------------------------
+ * Build: gcc -O2 -std=gnu11 -I. bench/bench_compare.c -o bench_compare
+ * Usage: ./bench_compare baseline.jsonl results.jsonl [results.jsonl ...]
+ *
+ * Both files hold bench_result() lines. A result that appears more than
+ * once (several suite runs appended to one file) counts with its best
+ * value: some costs move by a fifth from one process to the next, with
+ * where the heap and stack happen to land. A baseline line may add
+ * "threshold": the fraction a result may be worse by before it counts as
+ * a regression (default DEFAULT_THRESHOLD). Prints one row per result and
+ * exits 1 if anything regressed or has no baseline line: a result nobody
+ * listed could never be flagged, so it fails until its line is added. A
+ * baseline line without "value" lists a result whose cost depends too much
+ * on the machine to ship a number for (the GTK benchmarks): it is shown as
+ * not recorded, with the line to record, and does not fail the run.
+ * Baselines with no result (GTK benchmarks on a headless box) are listed
+ * as skipped and do not fail the run either.
+ *
+ * The baseline is only meaningful on the machine it was recorded on: after
+ * an intended change in cost, or on a new machine, replace it with a fresh
+ * results file (keeping the thresholds).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_RESULTS 256
+#define NAME_MAX_LEN 64
+#define DEFAULT_THRESHOLD 0.10
+
+typedef struct {
+    char name[NAME_MAX_LEN];
+    char unit[NAME_MAX_LEN];
+    double value;
+    double threshold;
+    int higher_is_better;
+    int recorded;               /* 0: a baseline line still waiting for its value */
+    int seen;
+} Result;
+
+/* The lines are our own flat output, so a key lookup is all the parsing needed */
+static const char *json_field(const char *line, const char *key) {
+    char pattern[NAME_MAX_LEN + 4];
+    const char *p;
+
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    return (p = strstr(line, pattern)) ? p + strlen(pattern) : NULL;
+}
+
+static int json_string(const char *line, const char *key, char *out, size_t size) {
+    const char *p = json_field(line, key), *end;
+
+    if (!p || *p != '"' || !(end = strchr(p + 1, '"')) || (size_t)(end - p - 1) >= size) return 0;
+    memcpy(out, p + 1, (size_t)(end - p - 1));
+    out[end - p - 1] = '\0';
+    return 1;
+}
+
+static int better_than(const Result *a, const Result *b) {
+    return a->higher_is_better ? a->value > b->value : a->value < b->value;
+}
+
+/* Appends the results in `path` to out[0..n), merging repeats; the new count, or -1 */
+static int load(const char *path, Result *out, int n, int max) {
+    FILE *f = fopen(path, "r");
+    char line[1024], better[16];
+
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+    while (fgets(line, sizeof(line), f) && n < max) {
+        const char *value = json_field(line, "value"), *threshold = json_field(line, "threshold");
+        Result *r = &out[n];
+
+        if (!json_string(line, "bench", r->name, sizeof(r->name))) continue;
+        if (!json_string(line, "unit", r->unit, sizeof(r->unit))) r->unit[0] = '\0';
+        r->recorded = value != NULL;
+        r->value = value ? strtod(value, NULL) : 0;
+        r->threshold = threshold ? strtod(threshold, NULL) : DEFAULT_THRESHOLD;
+        r->higher_is_better = json_string(line, "better", better, sizeof(better)) && strcmp(better, "higher") == 0;
+        r->seen = 0;
+
+        int j = 0;
+        while (j < n && strcmp(out[j].name, r->name) != 0) j++;
+        if (j == n) n++;
+        else if (r->recorded && (!out[j].recorded || better_than(r, &out[j]))) out[j] = *r;
+    }
+    fclose(f);
+    return n;
+}
+
+int main(int argc, char **argv) {
+    static Result baseline[MAX_RESULTS], results[MAX_RESULTS];
+    int n_base, n_results = 0, regressions = 0, unlisted = 0, pending = 0;
+
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s baseline.jsonl results.jsonl [results.jsonl ...]\n", argv[0]);
+        return 2;
+    }
+    if ((n_base = load(argv[1], baseline, 0, MAX_RESULTS)) < 0) return 2;
+    for (int i = 2; i < argc; i++)
+        if ((n_results = load(argv[i], results, n_results, MAX_RESULTS)) < 0) return 2;
+
+    printf("%-28s %14s %14s %9s  %s\n", "bench", "baseline", "result", "change", "status");
+    for (int i = 0; i < n_results; i++) {
+        const Result *r = &results[i];
+        Result *b = NULL;
+        double change, worse;
+
+        for (int j = 0; j < n_base && !b; j++)
+            if (strcmp(baseline[j].name, r->name) == 0) b = &baseline[j];
+        if (!b) {
+            printf("%-28s %14s %14.4g %9s  NO BASELINE (%s)\n", r->name, "-", r->value, "-", r->unit);
+            unlisted++;
+            continue;
+        }
+        b->seen = 1;
+        if (!b->recorded) {
+            printf("%-28s %14s %14.4g %9s  not recorded (%s)\n", r->name, "-", r->value, "-", r->unit);
+            printf("  to record: {\"bench\":\"%s\",\"value\":%.4g,\"unit\":\"%s\",\"better\":\"%s\",\"threshold\":%g}\n",
+                   r->name, r->value, b->unit, b->higher_is_better ? "higher" : "lower", b->threshold);
+            pending++;
+            continue;
+        }
+        change = b->value != 0 ? (r->value - b->value) / b->value : 0;
+        worse = b->higher_is_better ? -change : change;
+        printf("%-28s %14.4g %14.4g %+8.1f%%  %s (%s, limit %.0f%%)\n", r->name, b->value, r->value, 100 * change,
+               worse > b->threshold ? "REGRESSED" : worse < -b->threshold ? "improved" : "ok", b->unit,
+               100 * b->threshold);
+        regressions += worse > b->threshold;
+    }
+    for (int j = 0; j < n_base; j++)
+        if (!baseline[j].seen && baseline[j].recorded)
+            printf("%-28s %14.4g %14s %9s  skipped\n", baseline[j].name, baseline[j].value, "-", "-");
+        else if (!baseline[j].seen)
+            printf("%-28s %14s %14s %9s  skipped\n", baseline[j].name, "-", "-", "-");
+
+    if (regressions) printf("%d regression%s\n", regressions, regressions == 1 ? "" : "s");
+    if (unlisted)
+        printf("%d result%s without a baseline: add %s to %s\n", unlisted, unlisted == 1 ? "" : "s",
+               unlisted == 1 ? "its line" : "their lines", argv[1]);
+    if (pending)
+        printf("%d result%s not recorded for this machine yet (not a failure)\n", pending, pending == 1 ? "" : "s");
+    return (regressions || unlisted) ? 1 : 0;
+}
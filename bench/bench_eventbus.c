@@ -0,0 +1,166 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Benchmark: match event bus - publish cost, fan-out, slow consumers
+ * ----------------------------------------------------------------------------
+ * Build: gcc -O2 -std=gnu11 -pthread -I. bench/bench_eventbus.c eventbus.c outbuf.c rules.c -o bench_eventbus
+ * Usage: ./bench_eventbus [events] [consumers]
+ *
+ * publish      the producer alone, nobody subscribed
+ * fan-out      `consumers` threads read every event; the producer publishes
+ *              half a ring at a time and waits for all of them (the bus
+ *              itself never waits), so nothing is dropped and the figure is
+ *              deliveries per second across all consumers
+ * slow reader  the same consumers plus one that sleeps on every event: it
+ *              must be dropped, the others must still get everything, and
+ *              the producer must not slow down
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "bench.h"
+#include "eventbus.h"
+
+#define MAX_CONSUMERS 64
+
+typedef struct {
+    EventBus *bus;
+    EventSubscriber sub;
+    _Atomic uint64_t seen;             /* events read, for the producer to wait on */
+    _Atomic int ready;
+    int slow;
+    int bad;                           /* events out of order */
+    uint64_t sum;
+    pthread_t thread;
+} Consumer;
+
+static _Atomic int finished;
+
+static void *consumer_thread(void *arg) {
+    Consumer *c = arg;
+    MatchEvent e;
+    uint64_t next = 0;
+    int first = 1;
+
+    eventbus_subscribe(c->bus, &c->sub);
+    atomic_store(&c->ready, 1);
+    while (!atomic_load_explicit(&finished, memory_order_acquire) || eventbus_wait(&c->sub, 0) == 1) {
+        int r = eventbus_poll(&c->sub, &e);
+
+        if (r == EVENTBUS_DROPPED) break;
+        if (r == 0) {
+            eventbus_wait(&c->sub, 5);
+            continue;
+        }
+        if (!first && e.seq != next) c->bad++;
+        first = 0;
+        next = e.seq + 1;
+        c->sum += e.match;
+        atomic_store_explicit(&c->seen, c->sub.received, memory_order_release);
+        if (c->slow) usleep(1000);
+    }
+    return NULL;
+}
+
+static void make_event(MatchEvent *e, uint64_t i) {
+    e->time_ns = i;
+    e->match = (uint32_t)(i / 3);
+    e->type = EVENT_ROUND;
+    e->round = (uint8_t)(i % 3 + 1);
+    e->player_move = (uint8_t)(i % 3 + 1);
+    e->computer_move = (uint8_t)((i / 3) % 3 + 1);
+    e->result = (uint8_t)(i % 3);
+    e->player_score = e->computer_score = e->rules = 0;
+    e->reserved = 0;
+}
+
+static void start_consumers(Consumer *c, int n, EventBus *bus, int slow_one) {
+    atomic_store(&finished, 0);
+    for (int i = 0; i < n; i++) {
+        c[i] = (Consumer){ .bus = bus, .slow = slow_one && i == n - 1 };
+        pthread_create(&c[i].thread, NULL, consumer_thread, &c[i]);
+    }
+    for (int i = 0; i < n; i++)
+        while (!atomic_load(&c[i].ready)) sched_yield();
+}
+
+static void stop_consumers(Consumer *c, int n) {
+    atomic_store_explicit(&finished, 1, memory_order_release);
+    for (int i = 0; i < n; i++) pthread_join(c[i].thread, NULL);
+}
+
+int main(int argc, char **argv) {
+    uint64_t n = (argc > 1) ? strtoull(argv[1], NULL, 0) : 20000000ull;
+    int n_consumers = (argc > 2) ? atoi(argv[2]) : 4;
+    EventBus *bus = eventbus_new(0);
+    Consumer *c = calloc(MAX_CONSUMERS + 1, sizeof(*c));
+    uint64_t batch, t0, t1, fanout_events;
+    double publish_ns, slow_ns;
+    MatchEvent e;
+    int ok = 1;
+
+    if (!bus || !c || n_consumers < 1 || n_consumers > MAX_CONSUMERS) return 1;
+    batch = (EVENTBUS_DEFAULT_CAPACITY) / 2;
+
+    /* --- publish, nobody listening --- */
+    t0 = bench_now_ns();
+    for (uint64_t i = 0; i < n; i++) {
+        make_event(&e, i);
+        eventbus_publish(bus, &e);
+    }
+    t1 = bench_now_ns();
+    publish_ns = (double)(t1 - t0) / n;
+    printf("publish          %8.2f ns/event (%zu-byte events, ring of %d)\n", publish_ns, sizeof(MatchEvent),
+           EVENTBUS_DEFAULT_CAPACITY);
+
+    /* --- fan-out, every consumer keeps up --- */
+    fanout_events = n / 10 / batch * batch;
+    if (fanout_events == 0) fanout_events = batch;
+    start_consumers(c, n_consumers, bus, 0);
+    t0 = bench_now_ns();
+    for (uint64_t i = 0; i < fanout_events; i += batch) {
+        for (uint64_t j = 0; j < batch; j++) {
+            make_event(&e, i + j);
+            eventbus_publish(bus, &e);
+        }
+        for (int k = 0; k < n_consumers; k++)
+            while (atomic_load_explicit(&c[k].seen, memory_order_acquire) < i + batch) sched_yield();
+    }
+    t1 = bench_now_ns();
+    stop_consumers(c, n_consumers);
+    printf("fan-out          %8.2f M deliveries/s (%llu events x %d consumers)\n",
+           (double)fanout_events * n_consumers / ((double)(t1 - t0) / 1e9) / 1e6,
+           (unsigned long long)fanout_events, n_consumers);
+    for (int k = 0; k < n_consumers; k++)
+        if (c[k].sub.dropped || c[k].bad || c[k].sub.received != fanout_events) ok = 0;
+
+    /* --- one slow reader among them --- */
+    start_consumers(c, n_consumers + 1, bus, 1);
+    t0 = bench_now_ns();
+    for (uint64_t i = 0; i < fanout_events; i += batch) {
+        for (uint64_t j = 0; j < batch; j++) {
+            make_event(&e, i + j);
+            eventbus_publish(bus, &e);
+        }
+        for (int k = 0; k < n_consumers; k++)   /* the fast ones only */
+            while (atomic_load_explicit(&c[k].seen, memory_order_acquire) < i + batch) sched_yield();
+    }
+    t1 = bench_now_ns();
+    stop_consumers(c, n_consumers + 1);
+    slow_ns = (double)(t1 - t0) / fanout_events;
+    printf("slow reader      %s after %llu events; others %s; %.2f ns/event with the fast readers\n",
+           c[n_consumers].sub.dropped ? "dropped" : "NOT DROPPED", (unsigned long long)c[n_consumers].sub.received,
+           ok ? "complete" : "INCOMPLETE", slow_ns);
+    if (!c[n_consumers].sub.dropped) ok = 0;
+    for (int k = 0; k < n_consumers; k++)
+        if (c[k].sub.dropped || c[k].bad || c[k].sub.received != fanout_events) ok = 0;
+    printf("dropped          %llu subscribers in total\n", (unsigned long long)eventbus_dropped_subscribers(bus));
+
+    for (int k = 0; k <= n_consumers; k++) bench_consume(c[k].sum);
+    eventbus_free(bus);
+    free(c);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,73 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Benchmark: batch round resolution, scalar vs SSE2 vs AVX2
+ * ----------------------------------------------------------------------------
+ * Build: gcc -O2 -std=gnu11 -I. bench/bench_outcome.c outcome.c rng.c -o bench_outcome
+ * Usage: ./bench_outcome [rounds]
+ *
+ * Every kernel is first checked against outcome_of() on all 256 byte values
+ * and on the random batch; a mismatch fails the run.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "outcome.h"
+#include "rng.h"
+
+static const char *KERNELS[] = { "scalar", "sse2", "avx2" };
+
+/* Compare the selected kernel with the scalar rule; returns 0 on mismatch */
+static int verify_kernel(const uint8_t *packed, size_t n, uint8_t *outcomes, int8_t *scores) {
+    resolve_rounds(packed, n, outcomes, scores);
+    for (size_t i = 0; i < n; i++) {
+        int o = outcome_of((packed[i] >> 2) & 3, packed[i] & 3);
+        if (outcomes[i] != o || scores[i] != outcome_score(o)) {
+            fprintf(stderr, "%s: mismatch at %zu (byte 0x%02x)\n", outcome_kernel_name(), i, packed[i]);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    size_t n = (argc > 1) ? strtoull(argv[1], NULL, 0) : (1u << 24);
+    uint8_t *packed = malloc(n), *outcomes = malloc(n);
+    int8_t *scores = malloc(n);
+    uint8_t all_bytes[256], all_outcomes[256];
+    int8_t all_scores[256];
+    int reps = 20, failed = 0;
+    Rng rng;
+
+    rng_seed(&rng, 42);
+    for (size_t i = 0; i < n; i++)
+        packed[i] = pack_moves((int)rng_bounded(&rng, 3) + 1, (int)rng_bounded(&rng, 3) + 1);
+    for (int i = 0; i < 256; i++) all_bytes[i] = (uint8_t)i;
+
+    for (size_t k = 0; k < sizeof(KERNELS) / sizeof(KERNELS[0]); k++) {
+        if (!outcome_kernel_select(KERNELS[k])) {
+            printf("%-8s unavailable on this CPU\n", KERNELS[k]);
+            continue;
+        }
+        if (!verify_kernel(all_bytes, 256, all_outcomes, all_scores) ||
+            !verify_kernel(packed, n, outcomes, scores)) {
+            failed = 1;
+            continue;
+        }
+
+        uint64_t t0 = bench_now_ns();
+        for (int r = 0; r < reps; r++) resolve_rounds(packed, n, outcomes, scores);
+        uint64_t t1 = bench_now_ns();
+        bench_consume(outcomes[n / 2] + (uint64_t)scores[n / 3]);
+
+        printf("%-8s %10.1f Mrounds/s  %6.3f ns/round\n", KERNELS[k],
+               (double)n * reps * 1e3 / (double)(t1 - t0), (double)(t1 - t0) / ((double)n * reps));
+    }
+
+    free(packed);
+    free(outcomes);
+    free(scores);
+    return failed;
+}
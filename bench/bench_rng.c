@@ -0,0 +1,40 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Benchmark: computer move draws, libc rand() % 3 vs rng_bounded()
+ * ----------------------------------------------------------------------------
+ * Build: gcc -O2 -std=gnu11 -I. bench/bench_rng.c rng.c -o bench_rng
+ * Usage: ./bench_rng [draws]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "rng.h"
+
+int main(int argc, char **argv) {
+    uint64_t draws = (argc > 1) ? strtoull(argv[1], NULL, 0) : 100000000ULL;
+    uint64_t counts[2][3] = {{0}};
+    uint64_t t0, t1, t2;
+    Rng rng;
+
+    srand(12345);
+    rng_seed(&rng, 12345);
+
+    /* the old process_round() path */
+    t0 = bench_now_ns();
+    for (uint64_t i = 0; i < draws; i++) counts[0][rand() % 3]++;
+    t1 = bench_now_ns();
+    for (uint64_t i = 0; i < draws; i++) counts[1][rng_bounded(&rng, 3)]++;
+    t2 = bench_now_ns();
+
+    bench_consume(counts[0][0] + counts[1][0]);
+    printf("%-16s %10.1f Mdraws/s  %6.2f ns/draw\n", "rand() % 3",
+           draws * 1e3 / (double)(t1 - t0), (double)(t1 - t0) / draws);
+    printf("%-16s %10.1f Mdraws/s  %6.2f ns/draw\n", "rng_bounded(3)",
+           draws * 1e3 / (double)(t2 - t1), (double)(t2 - t1) / draws);
+    printf("distribution     rand: %llu/%llu/%llu  rng: %llu/%llu/%llu\n",
+           (unsigned long long)counts[0][0], (unsigned long long)counts[0][1], (unsigned long long)counts[0][2],
+           (unsigned long long)counts[1][0], (unsigned long long)counts[1][1], (unsigned long long)counts[1][2]);
+    return 0;
+}
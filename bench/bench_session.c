@@ -0,0 +1,96 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Benchmark: packed sessions - memory per session, create/destroy cost
+ * ----------------------------------------------------------------------------
+ * Build: gcc -O2 -std=gnu11 -I. bench/bench_session.c session.c pool.c engine.c strategy.c rules.c rng.c outcome.c -o bench_session
+ * Usage: ./bench_session [sessions]
+ *
+ * Keeps `sessions` matches alive at once with a few hundred distinct player
+ * names, plays every match out, then churns destroy/create. The table is
+ * reserved up front, so neither creating nor churning may grow the pool or
+ * the name table, i.e. no allocation happens; the churn phase also checks
+ * that every destroyed session's handle stopped resolving. Last, one session is
+ * destroyed and created REUSE_CYCLES times over, far more than a slot has
+ * generations, and none of the old handles may resolve.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "rng.h"
+#include "session.h"
+
+#define DISTINCT_NAMES 512
+#define REUSE_CYCLES 1000
+
+int main(int argc, char **argv) {
+    uint32_t n = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 4000000u;
+    SessionHandle *handles = malloc((size_t)n * sizeof(*handles));
+    char names[DISTINCT_NAMES][16];
+    SessionTable table;
+    uint64_t sink = 0, t0, t1;
+    uint32_t slabs, rejected = 0;
+    NameTable names_before;
+    int grew, names_grew;
+    Rng rng;
+
+    if (!handles) return 1;
+    for (int i = 0; i < DISTINCT_NAMES; i++) snprintf(names[i], sizeof(names[i]), "player%03d", i);
+    rng_seed(&rng, 1);
+    session_table_init(&table);
+    if (session_table_reserve(&table, n, DISTINCT_NAMES, sizeof(names)) < 0) return 1;
+    names_before = table.names;
+    slabs = table.games.n_slabs;
+
+    t0 = bench_now_ns();
+    for (uint32_t i = 0; i < n; i++) handles[i] = session_create(&table, names[i % DISTINCT_NAMES]);
+    t1 = bench_now_ns();
+    names_grew = table.names.slots != names_before.slots || table.names.names != names_before.names ||
+                 table.names.n_chunks != names_before.n_chunks;
+    grew = table.games.n_slabs != slabs;
+    printf("create (cold)    %8.2f ns/session (pool %s, names %s)\n", (double)(t1 - t0) / n,
+           grew ? "GREW" : "did not grow", names_grew ? "GREW" : "did not grow");
+    printf("memory           %8.2f bytes/session for %u live sessions (%zu-byte state, %u names)\n",
+           session_table_bytes_per_session(&table), n, sizeof(PackedGame), table.names.count);
+
+    t0 = bench_now_ns();
+    for (int r = 0; r < TOTAL_ROUNDS; r++) {
+        for (uint32_t i = 0; i < n; i++) {
+            PackedGame *g = session_get(&table, handles[i]);
+            sink += (uint64_t)packed_game_play_round(g, (int)rng_bounded(&rng, 3) + 1, (int)rng_bounded(&rng, 3) + 1);
+        }
+    }
+    t1 = bench_now_ns();
+    printf("play round       %8.2f ns/round\n", (double)(t1 - t0) / ((double)n * TOTAL_ROUNDS));
+
+    /* steady state: every create reuses a freed slot */
+    t0 = bench_now_ns();
+    for (uint32_t i = 0; i < n; i++) {
+        SessionHandle old = handles[i];
+        session_destroy(&table, old);
+        handles[i] = session_create(&table, names[(i * 7) % DISTINCT_NAMES]);
+        rejected += (session_get(&table, old) == NULL); /* stale handle must not resolve */
+    }
+    t1 = bench_now_ns();
+    grew |= table.games.n_slabs != slabs;
+    printf("destroy+create   %8.2f ns/session (pool %s)\n", (double)(t1 - t0) / n, grew ? "GREW" : "did not grow");
+    if (rejected != n) fprintf(stderr, "bench_session: %u of %u stale handles still resolved\n", n - rejected, n);
+
+    /* one slot over and over: its generations run out long before the end */
+    static SessionHandle reused[REUSE_CYCLES];
+    uint32_t resolved = 0;
+    for (int i = 0; i < REUSE_CYCLES; i++) {
+        if (i > 0) session_destroy(&table, reused[i - 1]);
+        reused[i] = session_create(&table, names[0]);
+    }
+    for (int i = 0; i < REUSE_CYCLES - 1; i++) resolved += (session_get(&table, reused[i]) != NULL);
+    printf("slot reuse       %d cycles, %u stale handles resolved, %u slots retired\n", REUSE_CYCLES, resolved,
+           table.games.retired);
+    if (resolved) fprintf(stderr, "bench_session: %u stale handles resolved after reusing one slot\n", resolved);
+
+    bench_consume(sink);
+    session_table_destroy(&table);
+    free(handles);
+    return (!grew && !names_grew && rejected == n && resolved == 0) ? 0 : 1;
+}
@@ -0,0 +1,57 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Benchmark: equilibrium solver - time to epsilon, thread scaling
+ * ----------------------------------------------------------------------------
+ * Build: gcc -O2 -std=gnu11 -pthread -I. bench/bench_solver.c solver.c rules.c rng.c -lm -o bench_solver
+ * Usage: ./bench_solver [epsilon] [random_moves]
+ *
+ * Solves every rule set (plain and with a double-value win for the first
+ * move, which moves the equilibrium off uniform), then a random
+ * random_moves x random_moves game (default 1024) on 1, 2, 4, ... threads
+ * up to the online cores.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "solver.h"
+
+static void run(const char *name, const PayoffMatrix *m, double epsilon, int threads) {
+    SolverConfig config = { epsilon, 0, threads, 0 };
+    SolverResult result;
+
+    if (solver_run(m, &config, &result) < 0) {
+        fprintf(stderr, "%s: solver failed\n", name);
+        return;
+    }
+    printf("%-16s %8dx%-5d %8d %10llu %12.3f %12.2g\n", name, m->rows, m->cols, result.threads,
+           (unsigned long long)result.iterations, result.seconds * 1e3, result.exploitability);
+    solver_result_free(&result);
+}
+
+int main(int argc, char **argv) {
+    double epsilon = (argc > 1) ? strtod(argv[1], NULL) : 1e-4;
+    int random_moves = (argc > 2) ? atoi(argv[2]) : 1024;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    float weights[RULES_MAX_MOVES];
+    PayoffMatrix m;
+    char name[32];
+
+    printf("%-16s %14s %8s %10s %12s %12s\n", "game", "size", "threads", "iterations", "ms", "gap");
+    for (int k = 0; k < RULES_ID_COUNT; k++) {
+        const RuleSet *r = &rule_sets[k];
+        if (payoff_from_rules(&m, r, NULL) == 0) run(r->name, &m, epsilon, 1);
+        payoff_free(&m);
+
+        for (int i = 0; i < RULES_MAX_MOVES; i++) weights[i] = (i == 0) ? 2.0f : 1.0f;
+        snprintf(name, sizeof(name), "%s weighted", r->name);
+        if (payoff_from_rules(&m, r, weights) == 0) run(name, &m, epsilon, 1);
+        payoff_free(&m);
+    }
+
+    if (payoff_random(&m, random_moves, random_moves, 1) < 0) return 1;
+    for (int t = 1; t <= (cores > 0 ? cores : 1); t *= 2) run("random", &m, epsilon * 10, t);
+    payoff_free(&m);
+    return 0;
+}
@@ -0,0 +1,64 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Benchmark: per-round cost of each strategy (choose + observe)
+ * ----------------------------------------------------------------------------
+ * Build: gcc -O2 -std=gnu11 -I. bench/bench_strategy.c engine.c strategy.c rules.c rng.c outcome.c -o bench_strategy
+ * Usage: ./bench_strategy [rounds]
+ *
+ * Also prints how often each strategy beats a few exploitable opponents, to
+ * show the predictors actually learn.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "engine.h"
+#include "rng.h"
+
+#define OPP_MOVES 4096 /* opponent move tape, small enough to stay in cache */
+
+static const char *TARGETS[] = { "rock", "cycle", "random" };
+
+int main(int argc, char **argv) {
+    uint64_t rounds = (argc > 1) ? strtoull(argv[1], NULL, 0) : 50000000ULL;
+    uint8_t tape[OPP_MOVES];
+    Rng rng;
+
+    /* a biased, slightly patterned opponent so the predictors do real work */
+    rng_seed(&rng, 7);
+    for (int i = 0; i < OPP_MOVES; i++)
+        tape[i] = (uint8_t)((rng_bounded(&rng, 4) == 0) ? rng_bounded(&rng, 3) + 1 : (uint32_t)(i % 3) + 1);
+
+    printf("%-10s %12s", "strategy", "ns/round");
+    for (size_t t = 0; t < sizeof(TARGETS) / sizeof(TARGETS[0]); t++) printf("  %9s%%", TARGETS[t]);
+    printf("\n");
+
+    for (int k = 0; k < strategy_count; k++) {
+        Strategy *s = strategy_new(strategy_names[k], 1);
+        uint64_t sink = 0, t0, t1;
+
+        t0 = bench_now_ns();
+        for (uint64_t i = 0; i < rounds; i++) {
+            int opp = tape[i & (OPP_MOVES - 1)];
+            int own = s->choose(s);
+            if (s->observe) s->observe(s, own, opp);
+            sink += (uint64_t)own;
+        }
+        t1 = bench_now_ns();
+        bench_consume(sink);
+        printf("%-10s %12.2f", strategy_names[k], (double)(t1 - t0) / (double)rounds);
+
+        /* round win rate against exploitable opponents */
+        for (size_t t = 0; t < sizeof(TARGETS) / sizeof(TARGETS[0]); t++) {
+            Strategy *opp = strategy_new(TARGETS[t], 99);
+            MatchStats st;
+            simulate_matches(1000000, s, opp, &st);
+            printf("  %9.1f%%", 100.0 * (double)st.a_round_wins / (double)st.rounds);
+            strategy_free(opp);
+        }
+        printf("\n");
+        strategy_free(s);
+    }
+    return 0;
+}
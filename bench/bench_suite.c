@@ -0,0 +1,183 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Benchmark: regression suite - engine, RNG and batch simulation
+ * ----------------------------------------------------------------------------
+ * Build: gcc -O2 -std=gnu11 -I. bench/bench_suite.c engine.c strategy.c rules.c rng.c outcome.c -o bench_suite
+ * Usage: ./bench_suite [scale] > results.jsonl
+ *        ./bench_compare bench/baseline.jsonl results.jsonl
+ *
+ * Writes one JSON line per result (see bench_result() in bench.h). Every
+ * figure is the best of BENCH_REPEATS runs: the minimum is what the code
+ * costs, the rest is the machine being busy. `scale` multiplies the
+ * iteration counts (default 1; 0.1 for a quick look).
+ *
+ * round_resolve   one round as the GUI plays it since process_round()
+ *                 moved into the engine: the opponent chooses and observes,
+ *                 game_play_round() scores, a new game every TOTAL_ROUNDS
+ * decide_round    the outcome rule alone
+ * rng_next        one raw xoshiro256** draw
+ * rng_bounded     one unbiased draw in [0, 3), as for a random move
+ * simulate        simulate_matches(), markov vs random, in matches per second
+ * simulate_bo99   the same in a best of 99, which ends when decided
+ * clinch_*        a best of 99 ended when decided against the same matches
+ *                 played out to the last round: the speedup (the two are
+ *                 timed alternately, best of each) and the share of rounds
+ *                 saved. "fair" is markov vs random, an even match that
+ *                 mostly goes the distance; "lopsided" is markov vs cycle,
+ *                 over as soon as one side has 50 wins.
+ *
+ * The UI update cycle and cold start need GTK and a display: see
+ * bench_ui.c, which writes the same format.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "engine.h"
+#include "rng.h"
+
+#define BENCH_REPEATS 5
+#define TAPE_MOVES 4096 /* player move tape, small enough to stay in cache */
+
+static uint8_t tape[TAPE_MOVES];
+
+static double best_ns_per_op(double (*run)(uint64_t), uint64_t n) {
+    double best = 0;
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        double ns = run(n);
+        if (r == 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+static double run_round_resolve(uint64_t n) {
+    Strategy *opponent = strategy_new("markov", 1);
+    GameState game;
+    uint64_t sink = 0, t0, t1;
+
+    game_reset(&game);
+    t0 = bench_now_ns();
+    for (uint64_t i = 0; i < n; i++) {
+        int user_choice = tape[i & (TAPE_MOVES - 1)];
+        int computer_choice = opponent->choose(opponent);
+        if (opponent->observe) opponent->observe(opponent, computer_choice, user_choice);
+        sink += (uint64_t)game_play_round(&game, user_choice, computer_choice);
+        if (game_is_over(&game)) {
+            sink += (uint64_t)game_winner(&game);
+            game_reset(&game);
+        }
+    }
+    t1 = bench_now_ns();
+    bench_consume(sink);
+    strategy_free(opponent);
+    return (double)(t1 - t0) / (double)n;
+}
+
+static double run_decide_round(uint64_t n) {
+    uint64_t sink = 0, t0, t1;
+
+    t0 = bench_now_ns();
+    for (uint64_t i = 0; i < n; i++)
+        sink += (uint64_t)decide_round(tape[i & (TAPE_MOVES - 1)], tape[(i * 7 + 3) & (TAPE_MOVES - 1)]);
+    t1 = bench_now_ns();
+    bench_consume(sink);
+    return (double)(t1 - t0) / (double)n;
+}
+
+static double run_rng_next(uint64_t n) {
+    uint64_t sink = 0, t0, t1;
+    Rng rng;
+
+    rng_seed(&rng, 12345);
+    t0 = bench_now_ns();
+    for (uint64_t i = 0; i < n; i++) sink ^= rng_next(&rng);
+    t1 = bench_now_ns();
+    bench_consume(sink);
+    return (double)(t1 - t0) / (double)n;
+}
+
+static double run_rng_bounded(uint64_t n) {
+    uint64_t counts[3] = { 0, 0, 0 }, t0, t1;
+    Rng rng;
+
+    rng_seed(&rng, 12345);
+    t0 = bench_now_ns();
+    for (uint64_t i = 0; i < n; i++) counts[rng_bounded(&rng, 3)]++;
+    t1 = bench_now_ns();
+    bench_consume(counts[0] + counts[1] + counts[2]);
+    return (double)(t1 - t0) / (double)n;
+}
+
+static const char *simulate_opponent = "random";
+static uint64_t simulate_rounds;
+
+static double run_simulate(uint64_t n) {
+    Strategy *a = strategy_new("markov", 1);
+    Strategy *b = strategy_new(simulate_opponent, 2);
+    MatchStats stats;
+    uint64_t t0, t1;
+
+    t0 = bench_now_ns();
+    simulate_matches(n, a, b, &stats);
+    t1 = bench_now_ns();
+    bench_consume(stats.a_wins);
+    simulate_rounds = stats.rounds;
+    strategy_free(a);
+    strategy_free(b);
+    return (double)(t1 - t0) / (double)n;
+}
+
+/* Best of 99 ended when decided vs played out, timed alternately so both
+ * see the same machine; ns per match ended early in *ended_ns */
+static void run_clinch(const char *name, const char *opponent, uint64_t n, double *ended_ns) {
+    MatchFormat ended, played_out;
+    double best_ended = 0, best_played_out = 0;
+    uint64_t rounds_ended = 0, rounds_played_out = 0;
+    char metric[64];
+
+    match_format_parse("best-of-99", &ended);
+    match_format_parse("best-of-99,play-out", &played_out);
+    simulate_opponent = opponent;
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        double ns;
+
+        match_format = ended;
+        ns = run_simulate(n);
+        rounds_ended = simulate_rounds;
+        if (r == 0 || ns < best_ended) best_ended = ns;
+        match_format = played_out;
+        ns = run_simulate(n);
+        rounds_played_out = simulate_rounds;
+        if (r == 0 || ns < best_played_out) best_played_out = ns;
+    }
+    if (ended_ns) *ended_ns = best_ended;
+    snprintf(metric, sizeof(metric), "clinch_speedup_%s", name);
+    bench_result(stdout, metric, best_played_out / best_ended, "x", "higher");
+    snprintf(metric, sizeof(metric), "clinch_rounds_saved_%s", name);
+    bench_result(stdout, metric, 100.0 * (1.0 - (double)rounds_ended / (double)rounds_played_out), "%", "higher");
+}
+
+int main(int argc, char **argv) {
+    double scale = (argc > 1) ? strtod(argv[1], NULL) : 1.0;
+    uint64_t base = (uint64_t)(20000000.0 * (scale > 0 ? scale : 1.0));
+    Rng rng;
+
+    if (base == 0) base = 1;
+    rng_seed(&rng, 7);
+    for (int i = 0; i < TAPE_MOVES; i++) tape[i] = (uint8_t)(rng_bounded(&rng, 3) + 1);
+
+    bench_result(stdout, "round_resolve", best_ns_per_op(run_round_resolve, base), "ns/round", "lower");
+    bench_result(stdout, "decide_round", best_ns_per_op(run_decide_round, base * 5), "ns/round", "lower");
+    bench_result(stdout, "rng_next", best_ns_per_op(run_rng_next, base * 5), "ns/draw", "lower");
+    bench_result(stdout, "rng_bounded", best_ns_per_op(run_rng_bounded, base * 5), "ns/draw", "lower");
+    bench_result(stdout, "simulate", 1e3 / best_ns_per_op(run_simulate, base / TOTAL_ROUNDS), "M matches/s", "higher");
+
+    /* a long format, as many rounds' worth of matches as above */
+    uint64_t long_matches = base / 99 ? base / 99 : 1;
+    double ended_ns;
+    run_clinch("fair", "random", long_matches, &ended_ns);
+    bench_result(stdout, "simulate_bo99", 1e3 / ended_ns, "M matches/s", "higher");
+    run_clinch("lopsided", "cycle", long_matches, NULL);
+    return 0;
+}
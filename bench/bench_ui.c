@@ -0,0 +1,138 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Benchmark: regression suite - UI update cycle and cold start (GTK)
+ * ----------------------------------------------------------------------------
+ * Build: gcc -O2 -std=gnu11 -I. bench/bench_ui.c viewmodel.c $(pkg-config --cflags --libs gtk4) -o bench_ui
+ * Usage: ./bench_ui [cycles] [path/to/rps [launches]] > results.jsonl
+ *
+ * Writes bench_result() lines like bench_suite, and nothing at all when no
+ * display is available. bench/baseline.jsonl lists ui_cycle and cold_start
+ * without a value, so bench_compare reports them as not recorded instead
+ * of failing; give them the value printed on the machine that runs the
+ * bench to have them checked. A threshold of 0.25 and 0.30 leaves room
+ * for the noise of a compositor and of process start-up.
+ *
+ * ui_cycle        one round's worth of game-screen updates through the
+ *                 view-model, flushed: the apply_round() labels and CSS
+ *                 classes, then start_next_round_ui() putting them back.
+ *                 Widgets are real GTK labels and buttons, not on screen.
+ * cold_start      `rps` launched with RPS_EXIT_AFTER_FIRST_FRAME: main()
+ *                 through activate() until the first frame is painted, as
+ *                 reported by the app itself (RPS_STARTUP_TIME); median of
+ *                 `launches` runs, skipped without a path.
+ */
+
+#include <gtk/gtk.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "viewmodel.h"
+
+#define BENCH_REPEATS 5
+
+/* The game screen's slots, as main.c binds them */
+enum { SLOT_ROUND, SLOT_SCORE, SLOT_FEEDBACK, SLOT_RESULT, SLOT_CHOICES, SLOT_NEXT_ROUND, SLOT_COUNT };
+
+static void bind_game_screen(ViewModel *vm) {
+    vm_init(vm, NULL); /* no frame clock: the bench flushes by hand */
+    vm_bind(vm, SLOT_ROUND, g_object_ref_sink(gtk_label_new("Round 1 of 3")), VM_KIND_LABEL);
+    vm_bind(vm, SLOT_SCORE, g_object_ref_sink(gtk_label_new("You 0 - 0 PC")), VM_KIND_LABEL);
+    vm_bind(vm, SLOT_FEEDBACK, g_object_ref_sink(gtk_label_new("Make your move...")), VM_KIND_LABEL);
+    vm_bind(vm, SLOT_RESULT, g_object_ref_sink(gtk_label_new("")), VM_KIND_LABEL);
+    vm_bind(vm, SLOT_CHOICES, g_object_ref_sink(gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 10)), VM_KIND_WIDGET);
+    vm_bind(vm, SLOT_NEXT_ROUND, g_object_ref_sink(gtk_button_new_with_label("Next Round ->")), VM_KIND_BUTTON);
+}
+
+static double run_ui_cycle(ViewModel *vm, uint64_t cycles) {
+    static const char *const results[3] = { "It's a Draw.", "You Won!", "Computer Won." };
+    static const VmState states[3] = { VM_STATE_WARNING, VM_STATE_SUCCESS, VM_STATE_ERROR };
+    uint64_t t0 = bench_now_ns(), t1;
+
+    for (uint64_t i = 0; i < cycles; i++) {
+        int result = (int)(i % 3), round = (int)(i % 3) + 1;
+
+        /* apply_round() */
+        vm_set_textf(vm, SLOT_FEEDBACK, "You: %s  vs  PC: %s", "Rock", result == 2 ? "Paper" : "Scissors");
+        vm_set_text(vm, SLOT_RESULT, results[result]);
+        vm_set_state(vm, SLOT_RESULT, states[result]);
+        vm_set_textf(vm, SLOT_SCORE, "You %d - %d PC", (int)(i % 4), (int)(i % 3));
+        vm_set_visible(vm, SLOT_CHOICES, FALSE);
+        vm_set_text(vm, SLOT_NEXT_ROUND, "Next Round ->");
+        vm_set_visible(vm, SLOT_NEXT_ROUND, TRUE);
+        vm_flush(vm);
+
+        /* start_next_round_ui() */
+        vm_set_text(vm, SLOT_FEEDBACK, "Make your move...");
+        vm_set_text(vm, SLOT_RESULT, "");
+        vm_set_state(vm, SLOT_RESULT, VM_STATE_NONE);
+        vm_set_textf(vm, SLOT_ROUND, "Round %d of 3", round);
+        vm_set_visible(vm, SLOT_CHOICES, TRUE);
+        vm_set_visible(vm, SLOT_NEXT_ROUND, FALSE);
+        vm_flush(vm);
+    }
+    t1 = bench_now_ns();
+    return (double)(t1 - t0) / (double)cycles;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* Median milliseconds to the first frame, or a negative value if no run reported one */
+static double cold_start_ms(const char *rps, int launches) {
+    char *argv[] = { (char *)rps, NULL };
+    char **envp = g_get_environ();
+    double *ms = g_new(double, launches);
+    int n = 0;
+
+    envp = g_environ_setenv(envp, "RPS_EXIT_AFTER_FIRST_FRAME", "1", TRUE);
+    envp = g_environ_setenv(envp, "RPS_STARTUP_TIME", "1", TRUE);
+    envp = g_environ_setenv(envp, "RPS_LEADERBOARD", "", TRUE); /* no disk state in the measurement */
+    for (int i = 0; i < launches; i++) {
+        char *err = NULL;
+        const char *line;
+
+        if (!g_spawn_sync(NULL, argv, envp, G_SPAWN_STDOUT_TO_DEV_NULL, NULL, NULL, NULL, &err, NULL, NULL)) break;
+        if ((line = strstr(err, "first frame painted ")) != NULL)
+            ms[n++] = strtod(line + strlen("first frame painted "), NULL);
+        g_free(err);
+    }
+    g_strfreev(envp);
+
+    double median = -1;
+    if (n > 0) {
+        qsort(ms, (size_t)n, sizeof(*ms), compare_doubles);
+        median = ms[n / 2];
+    }
+    g_free(ms);
+    return median;
+}
+
+int main(int argc, char **argv) {
+    uint64_t cycles = (argc > 1) ? strtoull(argv[1], NULL, 0) : 200000ULL;
+    const char *rps = (argc > 2) ? argv[2] : NULL;
+    int launches = (argc > 3) ? atoi(argv[3]) : 9;
+    double best = 0;
+    ViewModel vm;
+
+    if (!gtk_init_check()) {
+        fprintf(stderr, "bench_ui: no display, skipped\n");
+        return 0;
+    }
+    bind_game_screen(&vm);
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        double ns = run_ui_cycle(&vm, cycles ? cycles : 1);
+        if (r == 0 || ns < best) best = ns;
+    }
+    bench_result(stdout, "ui_cycle", best, "ns/round", "lower");
+
+    if (rps && launches > 0) {
+        double ms = cold_start_ms(rps, launches);
+        if (ms >= 0) bench_result(stdout, "cold_start", ms, "ms", "lower");
+        else fprintf(stderr, "bench_ui: %s did not report a first frame\n", rps);
+    }
+    return 0;
+}
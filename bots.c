@@ -0,0 +1,257 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Bot-vs-bot streaming runs (GTK-free)
+ * ----------------------------------------------------------------------------
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "bots.h"
+#include "rng.h"
+#include "rules.h"
+#include "strategy.h"
+
+#define JSON_RECORD_MAX 192         /* longest record, with 20-digit numbers and the longest names */
+#define FRAGMENT_MAX 64
+
+/* Constant JSON pieces, built once per run so a record is a few memcpys */
+typedef struct {
+    char text[FRAGMENT_MAX];
+    size_t len;
+} Fragment;
+
+typedef struct {
+    Fragment a_move[RULES_MAX_MOVES + 1];   /* ,"a_move":"Rock" */
+    Fragment b_move[RULES_MAX_MOVES + 1];   /* ,"b_move":"Paper" */
+    Fragment result[3];                     /* ,"result":"draw"}\n */
+    Fragment players;                       /* ,"a":"markov","b":"random","a_score": */
+    Fragment winner[3];                     /* ,"winner":"a"}\n */
+} JsonFragments;
+
+static const char *const side_names[3] = { "draw", "a", "b" };   /* by RESULT_* */
+
+static void fragment_set(Fragment *f, const char *format, const char *x, const char *y) {
+    int n = snprintf(f->text, sizeof(f->text), format, x, y);
+    f->len = (n < 0 || n >= (int)sizeof(f->text)) ? 0 : (size_t)n;
+}
+
+static void json_fragments_init(JsonFragments *j, const char *a, const char *b) {
+    for (int m = 0; m <= RULES_MAX_MOVES; m++) {
+        const char *label = (m >= 1 && m <= rules->n_moves) ? rules->labels[m] : "?";
+        fragment_set(&j->a_move[m], ",\"a_move\":\"%s\"%s", label, "");
+        fragment_set(&j->b_move[m], ",\"b_move\":\"%s\"%s", label, "");
+    }
+    for (int r = 0; r < 3; r++) {
+        fragment_set(&j->result[r], ",\"result\":\"%s\"}\n%s", side_names[r], "");
+        fragment_set(&j->winner[r], ",\"winner\":\"%s\"}\n%s", side_names[r], "");
+    }
+    fragment_set(&j->players, ",\"a\":\"%s\",\"b\":\"%s\",\"a_score\":", a, b);
+}
+
+static inline char *put(char *p, const Fragment *f) {
+    return fmt_bytes(p, f->text, f->len);
+}
+
+/* --- Records --- */
+static inline int emit_round(OutBuf *out, const BotsConfig *config, const JsonFragments *j, uint64_t match,
+                             int round, int a, int b, int result) {
+    char *p;
+
+    if (config->format == BOTS_BINARY) {
+        if (!(p = outbuf_reserve(out, 1))) return -1;
+        *p++ = (char)rules_pack_round(a, b, result);
+    } else {
+        if (!(p = outbuf_reserve(out, JSON_RECORD_MAX))) return -1;
+        p = fmt_bytes(p, "{\"match\":", 9);
+        p = fmt_u64(p, match);
+        p = fmt_bytes(p, ",\"round\":", 9);
+        p = fmt_u64(p, (uint64_t)round);
+        p = put(p, &j->a_move[a & 7]);
+        p = put(p, &j->b_move[b & 7]);
+        p = put(p, &j->result[result]);
+    }
+    outbuf_commit(out, p);
+    return 0;
+}
+
+static inline int emit_match(OutBuf *out, const BotsConfig *config, const JsonFragments *j, uint64_t match,
+                             int a_score, int b_score, int rounds, int winner) {
+    char *p;
+
+    if (config->format == BOTS_BINARY) {
+        BotsMatchRecord rec = { (uint8_t)a_score, (uint8_t)b_score, (uint8_t)winner, (uint8_t)rounds };
+        if (!(p = outbuf_reserve(out, sizeof(rec)))) return -1;
+        p = fmt_bytes(p, &rec, sizeof(rec));
+    } else {
+        if (!(p = outbuf_reserve(out, JSON_RECORD_MAX))) return -1;
+        p = fmt_bytes(p, "{\"match\":", 9);
+        p = fmt_u64(p, match);
+        p = put(p, &j->players);
+        p = fmt_u64(p, (uint64_t)a_score);
+        p = fmt_bytes(p, ",\"b_score\":", 11);
+        p = fmt_u64(p, (uint64_t)b_score);
+        p = fmt_bytes(p, ",\"rounds\":", 10);
+        p = fmt_u64(p, (uint64_t)rounds);
+        p = put(p, &j->winner[winner]);
+    }
+    outbuf_commit(out, p);
+    return 0;
+}
+
+static int emit_header(OutBuf *out, const BotsConfig *config) {
+    BotsHeader h;
+    char *p;
+
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, BOTS_MAGIC, sizeof(BOTS_MAGIC));
+    h.version = BOTS_VERSION;
+    h.record_size = (config->records == BOTS_ROUNDS) ? 1 : sizeof(BotsMatchRecord);
+    h.rules = (uint16_t)rules->id;
+    h.records = (uint16_t)config->records;
+    h.max_rounds = (uint32_t)match_format.max_rounds;
+    h.format_kind = (uint8_t)match_format.kind;
+    h.format_target = (uint8_t)match_format.target;
+    h.format_flags = (uint8_t)((match_format.replay_draws ? BOTS_FORMAT_NO_DRAWS : 0) |
+                               (match_format.play_out ? BOTS_FORMAT_PLAY_OUT : 0));
+    if (!(p = outbuf_reserve(out, sizeof(h)))) return -1;
+    outbuf_commit(out, fmt_bytes(p, &h, sizeof(h)));
+    return 0;
+}
+
+/* --- Run --- */
+int bots_run(const BotsConfig *config, OutBuf *out, MatchStats *stats) {
+    StrategyStorage storage_a, storage_b;
+    Strategy *a = strategy_init(&storage_a, config->a, rng_derive_seed(config->seed, 0));
+    Strategy *b = strategy_init(&storage_b, config->b, rng_derive_seed(config->seed, 1));
+    const MatchFormat format = match_format;
+    JsonFragments j;
+    uint64_t round_wins[3] = { 0, 0, 0 }, match_wins[3] = { 0, 0, 0 };
+    uint64_t m;
+
+    if (!a || !b) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (config->format == BOTS_JSONL) json_fragments_init(&j, config->a, config->b);
+    else if (emit_header(out, config) < 0) return -1;
+
+    for (m = 0; m < config->matches; m++) {
+        int a_score = 0, b_score = 0, r = 0, winner;
+
+        do {
+            int move_a = a->choose(a);
+            int move_b = b->choose(b);
+            int result = rules_outcome(rules, move_a, move_b);
+
+            round_wins[result]++;
+            a_score += (result == RESULT_PLAYER_WIN);
+            b_score += (result == RESULT_COMPUTER_WIN);
+            if (a->observe) a->observe(a, move_a, move_b);
+            if (b->observe) b->observe(b, move_b, move_a);
+            r++;
+            if (config->records == BOTS_ROUNDS && emit_round(out, config, &j, m, r, move_a, move_b, result) < 0)
+                goto done;
+        } while (!match_format_decided(&format, a_score, b_score, r));
+        winner = (a_score > b_score) ? RESULT_PLAYER_WIN : (b_score > a_score) ? RESULT_COMPUTER_WIN : RESULT_DRAW;
+        match_wins[winner]++;
+        if (config->records == BOTS_MATCHES && emit_match(out, config, &j, m, a_score, b_score, r, winner) < 0)
+            break;
+    }
+done:
+    memset(stats, 0, sizeof(*stats));
+    stats->matches = m;
+    stats->a_wins = match_wins[RESULT_PLAYER_WIN];
+    stats->b_wins = match_wins[RESULT_COMPUTER_WIN];
+    stats->draws = match_wins[RESULT_DRAW];
+    stats->rounds = round_wins[0] + round_wins[1] + round_wins[2];
+    stats->a_round_wins = round_wins[RESULT_PLAYER_WIN];
+    stats->b_round_wins = round_wins[RESULT_COMPUTER_WIN];
+    stats->round_draws = round_wins[RESULT_DRAW];
+    return m == config->matches ? 0 : -1;
+}
+
+/* --- Command line --- */
+static void usage(const char *prog) {
+    fprintf(stderr, "usage: %s [-n matches] [-f jsonl|binary] [-g rounds|matches] [-o path] [-s seed]"
+                    " [-r classic|rpsls|rps7] [-m best-of-N|first-to-K[,no-draws][,max=R]] [strategy_a [strategy_b]]\n",
+            prog);
+    fprintf(stderr, "strategies:");
+    for (int i = 0; i < strategy_count; i++) fprintf(stderr, " %s", strategy_names[i]);
+    fprintf(stderr, "\n");
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int bots_main(int argc, char **argv) {
+    BotsConfig config = { "markov", "random", 1000000, rng_seed_from_env("RPS_SEED"), BOTS_JSONL, BOTS_ROUNDS };
+    const char *path = NULL;
+    int n_names = 0, fd = STDOUT_FILENO, status = 0;
+    OutBuf out;
+    MatchStats stats;
+    double begin, seconds;
+
+    if (!rules_select_from_env() || !match_format_select_from_env()) {
+        usage(argv[0]);
+        return 2;
+    }
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) config.matches = strtoull(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) config.seed = strtoull(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) path = argv[++i];
+        else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc && rules_select(argv[i + 1])) i++;
+        else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc && match_format_parse(argv[i + 1], &match_format)) i++;
+        else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc && strcmp(argv[i + 1], "jsonl") == 0) config.format = BOTS_JSONL, i++;
+        else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc && strcmp(argv[i + 1], "binary") == 0) config.format = BOTS_BINARY, i++;
+        else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc && strcmp(argv[i + 1], "rounds") == 0) config.records = BOTS_ROUNDS, i++;
+        else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc && strcmp(argv[i + 1], "matches") == 0) config.records = BOTS_MATCHES, i++;
+        else if (argv[i][0] != '-' && n_names == 0) config.a = argv[i], n_names++;
+        else if (argv[i][0] != '-' && n_names == 1) config.b = argv[i], n_names++;
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (path && (fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return 1;
+    }
+    if (outbuf_init(&out, fd, 0) < 0) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    begin = now_seconds();
+    if (bots_run(&config, &out, &stats) < 0 || outbuf_flush(&out) < 0) {
+        if (errno == EINVAL) usage(argv[0]);
+        else fprintf(stderr, "write: %s\n", strerror(errno));
+        status = (errno == EINVAL) ? 2 : 1;
+    }
+    seconds = now_seconds() - begin;
+
+    if (status == 0) {
+        uint64_t records = (config.records == BOTS_ROUNDS) ? stats.rounds : stats.matches;
+        fprintf(stderr, "%s vs %s, %s rules: %llu matches, a won %llu, b won %llu, %llu drawn\n", config.a,
+                config.b, rules->name, (unsigned long long)stats.matches, (unsigned long long)stats.a_wins,
+                (unsigned long long)stats.b_wins, (unsigned long long)stats.draws);
+        fprintf(stderr, "%llu records, %llu bytes in %.3f s: %.1f M records/s, %.0f MB/s\n",
+                (unsigned long long)records, (unsigned long long)out.written, seconds,
+                seconds > 0 ? records / seconds / 1e6 : 0.0, seconds > 0 ? out.written / seconds / 1e6 : 0.0);
+    }
+    outbuf_free(&out);
+    if (path && close(fd) < 0 && status == 0) {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        status = 1;
+    }
+    return status;
+}
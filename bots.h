@@ -0,0 +1,91 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Bot-vs-bot streaming runs (GTK-free)
+ * ----------------------------------------------------------------------------
+ * NOTE: Two named strategies play match after match at full speed and
+ * every round (or every match) is streamed out as one record, either
+ * as JSON Lines:
+ *
+ *   {"match":0,"round":1,"a_move":"Rock","b_move":"Paper","result":"b"}
+ *   {"match":0,"a":"markov","b":"random","a_score":2,"b_score":1,"rounds":3,"winner":"a"}
+ *
+ * (result and winner are "a", "b" or "draw"; moves are labels of the
+ * active rules), or packed binary, little-endian:
+ *
+ *   BotsHeader                           24 bytes, once
+ *   round records                         1 byte each: rules_pack_round(a, b, result)
+ *   or match records                      BotsMatchRecord, 4 bytes each
+ *
+ * Matches are played in the active format (see engine.h) and end as soon
+ * as they are decided, so matches differ in length: a round record's
+ * "round" (or its position after a match's last round) tells them apart,
+ * and the header records the format.
+ * Records go through an OutBuf (see outbuf.h), so the run never allocates
+ * after startup and writes in 1 MiB pieces.
+ */
+
+#ifndef RPS_BOTS_H
+#define RPS_BOTS_H
+
+#include <stdint.h>
+#include "engine.h"
+#include "outbuf.h"
+
+#define BOTS_MAGIC "RPSBOTS"
+#define BOTS_VERSION 2            /* 2: matches end when decided; format in the header */
+
+typedef enum {
+    BOTS_JSONL,
+    BOTS_BINARY
+} BotsFormat;
+
+typedef enum {
+    BOTS_ROUNDS,                /* one record per round */
+    BOTS_MATCHES                /* one record per match */
+} BotsRecords;
+
+typedef struct {
+    char magic[8];              /* BOTS_MAGIC, NUL-padded */
+    uint16_t version;
+    uint16_t record_size;       /* 1 for rounds, sizeof(BotsMatchRecord) for matches */
+    uint16_t rules;             /* RulesId the moves are numbered in */
+    uint16_t records;           /* BotsRecords */
+    uint32_t max_rounds;        /* longest a match can be */
+    uint8_t format_kind;        /* MatchFormatKind */
+    uint8_t format_target;      /* N rounds or K wins */
+    uint8_t format_flags;       /* BOTS_FORMAT_* */
+    uint8_t reserved;
+} BotsHeader;
+
+#define BOTS_FORMAT_NO_DRAWS 1
+#define BOTS_FORMAT_PLAY_OUT 2
+
+typedef struct {
+    uint8_t a_score;
+    uint8_t b_score;
+    uint8_t winner;             /* RESULT_*, "a" is the player side */
+    uint8_t rounds;             /* played, draws included */
+} BotsMatchRecord;
+
+_Static_assert(sizeof(BotsHeader) == 24, "BotsHeader layout");
+_Static_assert(sizeof(BotsMatchRecord) == 4, "BotsMatchRecord layout");
+
+typedef struct {
+    const char *a;              /* strategy registry names (see strategy.h) */
+    const char *b;
+    uint64_t matches;
+    uint64_t seed;
+    BotsFormat format;
+    BotsRecords records;
+} BotsConfig;
+
+/* Plays config->matches matches into `out` (header included, not flushed
+ * at the end) and fills `stats`. Returns 0, or -1 with errno set:
+ * EINVAL for an unknown strategy, else the write error. */
+int bots_run(const BotsConfig *config, OutBuf *out, MatchStats *stats);
+
+/* The command line behind tools/rps_bots and `rps --bots` */
+int bots_main(int argc, char **argv);
+
+#endif /* RPS_BOTS_H */
@@ -0,0 +1,259 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Scripted input driver (headless GUI stress runs)
+ * ----------------------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "driver.h"
+#include "histogram.h"
+
+#define DRIVE_DEFAULT_CLICKS 10000
+#define DRIVE_BURST 8               /* clicks per idle dispatch; frames still get their turn in between */
+#define DRIVE_DOUBLE_EVERY 7
+#define DRIVE_SETTLE_MS 250         /* after a window is destroyed, before counting what survived it */
+#define DRIVE_MAX_FAILURES 5        /* consistency failures printed; the rest are only counted */
+#define DRIVE_LEAK_TYPES 8
+
+/* A widget of a destroyed window; `alive` is cleared by its weak ref */
+typedef struct {
+    const char *type;
+    gboolean alive;
+} Tracked;
+
+typedef struct {
+    guint64 clicks_per_window;
+    int restarts;
+    gboolean double_click;
+
+    /* the window being driven */
+    GtkWidget *window;
+    GtkApplication *app;
+    DriveStepFunc step;
+    DriveCheckFunc check;
+    gpointer user_data;
+    DriveRestartFunc restart;
+    guint64 clicks;
+    gint64 begin_us;
+
+    /* whole run */
+    int windows;                /* destroyed and settled so far */
+    GRand *rand;
+    Histogram handler_ns;       /* one "clicked" emission, handlers included */
+    guint64 total_clicks;
+    guint64 waits;              /* dispatches with nothing to click yet */
+    double busy_seconds;
+    guint64 failures;
+    guint64 leaked;
+    long rss_first_kb;          /* after the first window was destroyed */
+    long rss_last_kb;
+    GPtrArray *tracked;         /* Tracked *, the last destroyed window's widgets */
+} Driver;
+
+static Driver *driver;
+static int config_state = -1;  /* -1 unread, 0 off, 1 on */
+
+/* --- Helpers --- */
+static guint64 now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (guint64)ts.tv_sec * 1000000000u + (guint64)ts.tv_nsec;
+}
+
+/* Resident set size from /proc/self/statm, -1 where there is none */
+static long rss_kb(void) {
+    long size, resident;
+    FILE *f = fopen("/proc/self/statm", "r");
+
+    if (!f) return -1;
+    if (fscanf(f, "%ld %ld", &size, &resident) != 2) resident = -1;
+    fclose(f);
+    return resident < 0 ? -1 : resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+gboolean drive_enabled(void) {
+    if (config_state < 0) {
+        const char *spec = g_getenv("RPS_DRIVE");
+        config_state = (spec && *spec && strcmp(spec, "0") != 0);
+    }
+    return config_state;
+}
+
+/* "clicks[:restarts[:double]]" */
+static void drive_setup(void) {
+    const char *spec = g_getenv("RPS_DRIVE");
+    char *end;
+
+    driver = g_new0(Driver, 1);
+    driver->clicks_per_window = strtoull(spec, &end, 10);
+    if (driver->clicks_per_window == 0) driver->clicks_per_window = DRIVE_DEFAULT_CLICKS;
+    if (*end == ':') driver->restarts = (int)strtol(end + 1, &end, 10);
+    if (*end == ':') driver->double_click = (strcmp(end + 1, "double") == 0);
+    driver->rand = g_rand_new();
+    driver->tracked = g_ptr_array_new();
+    hist_init(&driver->handler_ns);
+}
+
+/* --- Leak tracking --- */
+static void on_tracked_finalized(gpointer user_data, GObject *where_the_object_was) {
+    (void)where_the_object_was;
+    ((Tracked *)user_data)->alive = FALSE;
+}
+
+/* Weak-ref `widget` and everything below it */
+static void track_tree(GtkWidget *widget) {
+    Tracked *t = g_new(Tracked, 1);
+
+    for (GtkWidget *child = gtk_widget_get_first_child(widget); child; child = gtk_widget_get_next_sibling(child))
+        track_tree(child);
+    t->type = G_OBJECT_TYPE_NAME(widget);
+    t->alive = TRUE;
+    g_object_weak_ref(G_OBJECT(widget), on_tracked_finalized, t);
+    g_ptr_array_add(driver->tracked, t);
+}
+
+/* Count the survivors of the last window, "GtkLabel x3, GtkBox x1" into
+ * `types`. A survivor's record stays allocated: its weak ref still points
+ * at it. */
+static guint collect_leaks(char *types, size_t size) {
+    const char *names[DRIVE_LEAK_TYPES];
+    guint counts[DRIVE_LEAK_TYPES], n_types = 0, leaked = 0;
+    size_t len = 0;
+
+    for (guint i = 0; i < driver->tracked->len; i++) {
+        Tracked *t = g_ptr_array_index(driver->tracked, i);
+        guint k;
+
+        if (!t->alive) {
+            g_free(t);
+            continue;
+        }
+        leaked++;
+        for (k = 0; k < n_types && names[k] != t->type; k++) {}
+        if (k == n_types && n_types < DRIVE_LEAK_TYPES) {
+            names[n_types] = t->type;
+            counts[n_types++] = 0;
+        }
+        if (k < n_types) counts[k]++;
+    }
+    g_ptr_array_set_size(driver->tracked, 0);
+
+    types[0] = '\0';
+    for (guint k = 0; k < n_types && len < size; k++)
+        len += (size_t)g_snprintf(types + len, size - len, "%s%s x%u", k ? ", " : "", names[k], counts[k]);
+    return leaked;
+}
+
+/* --- Driving --- */
+static void click(GtkWidget *button) {
+    guint64 begin = now_ns();
+    g_signal_emit_by_name(button, "clicked");
+    hist_record(&driver->handler_ns, now_ns() - begin);
+}
+
+static void drive_report(void) {
+    Driver *d = driver;
+
+    fprintf(stderr, "drive: %llu clicks over %d window%s, %.0f callbacks/s while clicking, %llu waits\n",
+            (unsigned long long)d->total_clicks, d->windows, d->windows == 1 ? "" : "s",
+            d->busy_seconds > 0 ? (double)d->total_clicks / d->busy_seconds : 0.0, (unsigned long long)d->waits);
+    hist_print(&d->handler_ns, "drive: clicked handler", "us", 1000.0, stderr);
+    if (d->windows > 1 && d->rss_first_kb >= 0)
+        fprintf(stderr, "drive: rss %ld kB -> %ld kB, %+.1f kB per rebuild\n", d->rss_first_kb, d->rss_last_kb,
+                (double)(d->rss_last_kb - d->rss_first_kb) / (d->windows - 1));
+    fprintf(stderr, "drive: %llu widgets outlived their window, %llu consistency failures\n",
+            (unsigned long long)d->leaked, (unsigned long long)d->failures);
+}
+
+/* The last window has had time to finalize: count what it left behind,
+ * then rebuild or finish */
+static gboolean on_drive_settled(gpointer user_data) {
+    Driver *d = user_data;
+    char types[256];
+    guint leaked = collect_leaks(types, sizeof(types));
+    long rss = rss_kb();
+
+    d->windows++;
+    d->leaked += leaked;
+    d->rss_last_kb = rss;
+    if (d->windows == 1) d->rss_first_kb = rss;
+    fprintf(stderr, "drive: window %d: rss %ld kB (%+ld since window 1), %u widgets alive%s%s\n", d->windows, rss,
+            rss - d->rss_first_kb, leaked, leaked ? ": " : "", types);
+
+    if (d->windows <= d->restarts) {
+        d->restart(d->app);     /* comes back through drive_attach() */
+    } else {
+        drive_report();
+        g_application_release(G_APPLICATION(d->app));
+        g_application_quit(G_APPLICATION(d->app));
+    }
+    return G_SOURCE_REMOVE;
+}
+
+static void finish_window(Driver *d) {
+    double seconds = (g_get_monotonic_time() - d->begin_us) / (double)G_USEC_PER_SEC;
+
+    d->busy_seconds += seconds;
+    fprintf(stderr, "drive: window %d: %llu clicks in %.2f s, %.0f callbacks/s\n", d->windows + 1,
+            (unsigned long long)d->clicks, seconds, seconds > 0 ? (double)d->clicks / seconds : 0.0);
+
+    track_tree(d->window);
+    gtk_window_destroy(GTK_WINDOW(d->window));
+    d->window = NULL;
+    g_timeout_add(DRIVE_SETTLE_MS, on_drive_settled, d);
+}
+
+/* Up to DRIVE_BURST clicks, then back to the main loop so frames, the
+ * results idle and network replies get their turn */
+static gboolean on_drive_idle(gpointer user_data) {
+    Driver *d = user_data;
+
+    for (int i = 0; i < DRIVE_BURST; i++) {
+        GtkWidget *target = d->step(d->user_data, g_rand_int(d->rand));
+        const char *problem;
+
+        if (!target) {
+            d->waits++;
+            break;
+        }
+        click(target);
+        if (d->double_click && d->total_clicks % DRIVE_DOUBLE_EVERY == 0) click(target);
+        d->clicks++;
+        d->total_clicks++;
+
+        if (d->check && (problem = d->check(d->user_data)) && d->failures++ < DRIVE_MAX_FAILURES)
+            fprintf(stderr, "drive: click %llu: %s\n", (unsigned long long)d->total_clicks, problem);
+        if (d->clicks >= d->clicks_per_window) {
+            finish_window(d);
+            return G_SOURCE_REMOVE;
+        }
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+void drive_attach(GtkWidget *window, DriveStepFunc step, DriveCheckFunc check, gpointer user_data,
+                  DriveRestartFunc restart) {
+    if (!drive_enabled()) return;
+    if (!driver) {
+        drive_setup();
+        driver->app = gtk_window_get_application(GTK_WINDOW(window));
+        g_application_hold(G_APPLICATION(driver->app)); /* keep running while no window exists */
+    }
+    driver->window = window;
+    driver->step = step;
+    driver->check = check;
+    driver->user_data = user_data;
+    driver->restart = restart;
+    driver->clicks = 0;
+    driver->begin_us = g_get_monotonic_time();
+    g_idle_add(on_drive_idle, driver);
+}
+
+int drive_status(void) {
+    return (driver && (driver->leaked || driver->failures)) ? 1 : 0;
+}
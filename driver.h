@@ -0,0 +1,48 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Scripted input driver (headless GUI stress runs)
+ * ----------------------------------------------------------------------------
+ * NOTE: Off unless RPS_DRIVE is set. Then an idle source clicks through the
+ * real GtkApplication as fast as the main loop allows: each click is a
+ * "clicked" emission on the actual button, so it runs the same handlers a
+ * mouse would -- name screen, every move, Next Round, Rematch, and round
+ * again. The delay before the final results is skipped.
+ *
+ *   RPS_DRIVE=clicks[:restarts[:double]]
+ *     clicks     clicks per window (default 10000)
+ *     restarts   times the window is destroyed and rebuilt (default 0)
+ *     double     every 7th click is a double click: the same button twice
+ *                before the next frame, as a fast or bouncy finger would
+ *
+ * GTK 4 has no offscreen backend; run it under broadway for a headless box:
+ *   broadwayd :5 &  GDK_BACKEND=broadway BROADWAY_DISPLAY=:5 RPS_DRIVE=5000:50 ./rps
+ * (xvfb-run works as well). A line per window and a summary go to stderr:
+ * callbacks per second with the handler-time p50/p99, resident memory
+ * after each rebuild, and widgets still alive after their window was
+ * destroyed, by type. The exit status is 1 when anything leaked or a
+ * consistency check failed.
+ */
+
+#ifndef RPS_DRIVER_H
+#define RPS_DRIVER_H
+
+#include <gtk/gtk.h>
+
+/* The control to click next, or NULL to let the main loop run first (a
+ * result or server reply is pending). `roll` is random, for picking moves. */
+typedef GtkWidget *(*DriveStepFunc)(gpointer user_data, guint32 roll);
+/* NULL if the app state is consistent, else what is wrong */
+typedef const char *(*DriveCheckFunc)(gpointer user_data);
+/* Build a fresh window for `app` (and call drive_attach() again) */
+typedef void (*DriveRestartFunc)(GtkApplication *app);
+
+/* Reads RPS_DRIVE */
+gboolean drive_enabled(void);
+/* Start (or, after a restart, continue) driving `window` */
+void drive_attach(GtkWidget *window, DriveStepFunc step, DriveCheckFunc check, gpointer user_data,
+                  DriveRestartFunc restart);
+/* Exit status for the run: 1 if a widget leaked or a check failed */
+int drive_status(void);
+
+#endif /* RPS_DRIVER_H */
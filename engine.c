@@ -0,0 +1,159 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Game engine (GTK-free)
+ * ----------------------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "engine.h"
+
+MatchFormat match_format = { FORMAT_BEST_OF, TOTAL_ROUNDS, 0, 0, TOTAL_ROUNDS };
+
+/* --- Rules --- */
+/* Decide a single round: 0 draw, 1 player win, 2 computer win (one table load) */
+int decide_round(int player_choice, int computer_choice) {
+    return rules_outcome(rules, player_choice, computer_choice);
+}
+
+/* Upper-case display name for a move */
+const char *choice_name(int choice) {
+    return rules_valid_move(rules, choice) ? rules->names[choice] : "?";
+}
+
+/* --- Match format --- */
+int match_format_parse(const char *spec, MatchFormat *out) {
+    MatchFormat f = { FORMAT_BEST_OF, 0, 0, 0, 0 };
+    const char *p;
+    char *end;
+    long n;
+
+    if (!spec) return 0;
+    if (strncmp(spec, "best-of-", 8) == 0) p = spec + 8;
+    else if (strncmp(spec, "first-to-", 9) == 0) f.kind = FORMAT_FIRST_TO, p = spec + 9;
+    else return 0;
+    n = strtol(p, &end, 10);
+    /* first to K can take 2K - 1 decisive rounds */
+    if (end == p || n < 1 || n > (f.kind == FORMAT_FIRST_TO ? (MATCH_ROUNDS_MAX + 1) / 2 : MATCH_ROUNDS_MAX)) return 0;
+    f.target = (int)n;
+
+    for (p = end; *p == ','; p = end) {
+        p++;
+        if (strncmp(p, "no-draws", 8) == 0 && (p[8] == ',' || p[8] == '\0')) f.replay_draws = 1, end = (char *)p + 8;
+        else if (strncmp(p, "play-out", 8) == 0 && (p[8] == ',' || p[8] == '\0')) f.play_out = 1, end = (char *)p + 8;
+        else if (strncmp(p, "max=", 4) == 0) {
+            n = strtol(p + 4, &end, 10);
+            if (end == p + 4 || n < 1 || n > MATCH_ROUNDS_MAX) return 0;
+            f.max_rounds = (int)n;
+        } else return 0;
+    }
+    if (*p != '\0') return 0;
+
+    /* a plain best of N needs no cap beyond N; with draws not counting it could go on forever */
+    if (f.max_rounds == 0)
+        f.max_rounds = (f.kind == FORMAT_BEST_OF && !f.replay_draws) ? f.target : MATCH_ROUNDS_MAX;
+    *out = f;
+    return 1;
+}
+
+int match_format_select_from_env(void) {
+    const char *spec = getenv("RPS_FORMAT");
+    return !spec || !*spec || match_format_parse(spec, &match_format);
+}
+
+const char *match_format_spec(const MatchFormat *f, char *buf, size_t size) {
+    int implicit_max = (f->kind == FORMAT_BEST_OF && !f->replay_draws) ? f->target : MATCH_ROUNDS_MAX;
+    char max[16] = "";
+
+    if (f->max_rounds != implicit_max) snprintf(max, sizeof(max), ",max=%d", f->max_rounds);
+    snprintf(buf, size, "%s-%d%s%s%s", f->kind == FORMAT_FIRST_TO ? "first-to" : "best-of", f->target,
+             f->replay_draws ? ",no-draws" : "", f->play_out ? ",play-out" : "", max);
+    return buf;
+}
+
+/* --- Single game --- */
+void game_reset(GameState *game) {
+    memset(game, 0, sizeof(*game));
+    game->current_round = 1;
+}
+
+/* Play one round, update scores and advance the round counter.
+ * Once the match is decided the counter is one past the last round played
+ * (the GUI shows "Calculating Results..." in that state). */
+int game_play_round(GameState *game, int player_choice, int computer_choice) {
+    int result = decide_round(player_choice, computer_choice);
+
+    if (result == RESULT_PLAYER_WIN) game->player_score++;
+    else if (result == RESULT_COMPUTER_WIN) game->computer_score++;
+
+    game->last_player_choice = player_choice;
+    game->last_computer_choice = computer_choice;
+    game->last_result = result;
+    game->current_round++;
+    return result;
+}
+
+int game_is_over(const GameState *game) {
+    return match_format_decided(&match_format, game->player_score, game->computer_score, game->current_round - 1);
+}
+
+/* Overall match result using the same RESULT_* codes as a round */
+int game_winner(const GameState *game) {
+    if (game->player_score > game->computer_score) return RESULT_PLAYER_WIN;
+    if (game->computer_score > game->player_score) return RESULT_COMPUTER_WIN;
+    return RESULT_DRAW;
+}
+
+/* --- Batch simulation --- */
+/* Run n matches of a vs b in the active format, each stopped as soon as it
+ * is decided. Counters stay in locals on the hot path and are written to
+ * out_stats once at the end. */
+void simulate_matches(uint64_t n, Strategy *strategy_a, Strategy *strategy_b, MatchStats *out_stats) {
+    const MatchFormat format = match_format; /* a local copy the compiler can keep in registers */
+    uint64_t a_wins = 0, b_wins = 0, draws = 0;
+    uint64_t round_wins[3] = {0, 0, 0}; /* indexed by RESULT_* */
+
+    for (uint64_t m = 0; m < n; m++) {
+        int a_score = 0, b_score = 0, played = 0;
+
+        do {
+            int a = strategy_a->choose(strategy_a);
+            int b = strategy_b->choose(strategy_b);
+            int result = decide_round(a, b);
+
+            round_wins[result]++;
+            a_score += (result == RESULT_PLAYER_WIN);
+            b_score += (result == RESULT_COMPUTER_WIN);
+
+            if (strategy_a->observe) strategy_a->observe(strategy_a, a, b);
+            if (strategy_b->observe) strategy_b->observe(strategy_b, b, a);
+        } while (!match_format_decided(&format, a_score, b_score, ++played));
+
+        a_wins += (a_score > b_score);
+        b_wins += (b_score > a_score);
+        draws += (a_score == b_score);
+    }
+
+    out_stats->matches = n;
+    out_stats->a_wins = a_wins;
+    out_stats->b_wins = b_wins;
+    out_stats->draws = draws;
+    out_stats->rounds = round_wins[0] + round_wins[1] + round_wins[2];
+    out_stats->a_round_wins = round_wins[RESULT_PLAYER_WIN];
+    out_stats->b_round_wins = round_wins[RESULT_COMPUTER_WIN];
+    out_stats->round_draws = round_wins[RESULT_DRAW];
+}
+
+/* Add one set of totals into another (used to combine per-worker stats) */
+void match_stats_merge(MatchStats *into, const MatchStats *from) {
+    into->matches += from->matches;
+    into->a_wins += from->a_wins;
+    into->b_wins += from->b_wins;
+    into->draws += from->draws;
+    into->rounds += from->rounds;
+    into->a_round_wins += from->a_round_wins;
+    into->b_round_wins += from->b_round_wins;
+    into->round_draws += from->round_draws;
+}
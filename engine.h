@@ -0,0 +1,116 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Game engine (GTK-free)
+ * ----------------------------------------------------------------------------
+ * NOTE: Round rules, scoring and batch simulation live here so the GUI and
+ * offline load/regression runs share one code path. Nothing in this module
+ * touches GTK.
+ *
+ * Match formats: best of N rounds (optionally with drawn rounds replayed)
+ * or first to K round wins, chosen once at startup like the rules:
+ * RPS_FORMAT=best-of-5 | best-of-5,no-draws | first-to-3 [,max=R]. A
+ * match ends the moment it is decided -- when the side behind can no
+ * longer catch up -- not when its rounds run out, so a 2-0 best of 3 is
+ * two rounds. Both sides of a networked game must agree on the format.
+ */
+
+#ifndef RPS_ENGINE_H
+#define RPS_ENGINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "rules.h"
+#include "strategy.h"
+
+/* --- Game Constants --- */
+/* Classic moves; other variants number theirs in rules.h */
+#define CHOICE_ROCK CLASSIC_ROCK
+#define CHOICE_PAPER CLASSIC_PAPER
+#define CHOICE_SCISSORS CLASSIC_SCISSORS
+#define TOTAL_ROUNDS 3             /* rounds of the default format, best of 3 */
+#define MATCH_ROUNDS_MAX 250       /* round numbers travel as one byte (logs, sessions, events) */
+
+/* Round/match result codes (0 draw, 1 player win, 2 computer win) */
+#define RESULT_DRAW 0
+#define RESULT_PLAYER_WIN 1
+#define RESULT_COMPUTER_WIN 2
+
+/* --- Match format --- */
+typedef enum {
+    FORMAT_BEST_OF,            /* `target` rounds; more round wins takes the match */
+    FORMAT_FIRST_TO            /* first to `target` round wins; draws never count */
+} MatchFormatKind;
+
+typedef struct {
+    MatchFormatKind kind;
+    int target;                /* N rounds (best of) or K wins (first to) */
+    int replay_draws;          /* best of: a drawn round does not use up one of the N */
+    int play_out;              /* best of: play all N even once decided (reference runs only) */
+    int max_rounds;            /* hard cap, draws included; the score decides when it is hit */
+} MatchFormat;
+
+/* The active format; best of 3 unless selected otherwise */
+extern MatchFormat match_format;
+
+/* Parse "best-of-N" / "first-to-K" with optional ",no-draws", ",max=R" and
+ * ",play-out"; 0 (and *out untouched) if the spec is not valid */
+int match_format_parse(const char *spec, MatchFormat *out);
+/* Apply RPS_FORMAT if set; returns 0 if it is not a valid format */
+int match_format_select_from_env(void);
+/* The spec match_format_parse() reads back, e.g. "first-to-3" */
+const char *match_format_spec(const MatchFormat *f, char *buf, size_t size);
+
+/* Is a match with these scores after `rounds_played` rounds over? Either
+ * a side reached the target, or the side behind cannot catch up in the
+ * rounds left, or the cap was hit. */
+static inline int match_format_decided(const MatchFormat *f, int a_score, int b_score, int rounds_played) {
+    int counted, left;
+
+    if (rounds_played >= f->max_rounds) return 1;
+    if (f->kind == FORMAT_FIRST_TO) return a_score >= f->target || b_score >= f->target;
+    counted = f->replay_draws ? a_score + b_score : rounds_played;
+    left = f->target - counted;
+    return left <= 0 || (!f->play_out && abs(a_score - b_score) > left);
+}
+
+/* --- Data Structures --- */
+typedef struct {
+    int current_round;        /* current round index (1-based); one past the last once over */
+    int player_score;         /* player cumulative score */
+    int computer_score;       /* computer cumulative score */
+    int last_player_choice;   /* moves of the most recent round (0 if none) */
+    int last_computer_choice;
+    int last_result;          /* RESULT_* of the most recent round */
+} GameState;
+
+/* Totals from simulate_matches(); "a" is the player side, "b" the computer.
+ * `rounds` counts rounds actually played, which early ends make fewer than
+ * matches x format length. */
+typedef struct {
+    uint64_t matches;
+    uint64_t a_wins;
+    uint64_t b_wins;
+    uint64_t draws;
+    uint64_t rounds;
+    uint64_t a_round_wins;
+    uint64_t b_round_wins;
+    uint64_t round_draws;
+} MatchStats;
+
+/* --- Rules (the active RuleSet, see rules.h) --- */
+int decide_round(int player_choice, int computer_choice);
+const char *choice_name(int choice);
+
+/* --- Single game --- */
+void game_reset(GameState *game);
+int game_play_round(GameState *game, int player_choice, int computer_choice);
+int game_is_over(const GameState *game);
+int game_winner(const GameState *game);
+
+/* --- Batch simulation --- */
+void simulate_matches(uint64_t n, Strategy *strategy_a, Strategy *strategy_b, MatchStats *out_stats);
+void match_stats_merge(MatchStats *into, const MatchStats *from);
+
+#endif /* RPS_ENGINE_H */
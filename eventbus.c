@@ -0,0 +1,285 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Match event bus (GTK-free)
+ * ----------------------------------------------------------------------------
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include "engine.h"
+#include "eventbus.h"
+#include "outbuf.h"
+#include "rules.h"
+
+#define EVENT_WORDS (sizeof(MatchEvent) / sizeof(uint64_t))
+#define WAIT_SLICE_NS 10000000L         /* longest a sleeper can miss a wake-up by */
+
+/* One cache line per slot, so a reader of one event never shares a line
+ * with the producer writing the next */
+typedef struct {
+    _Alignas(64) _Atomic uint64_t seq;  /* 2p+1 while event p is written, 2p+2 once it is */
+    _Atomic uint64_t words[EVENT_WORDS];
+} EventSlot;
+
+struct EventBus {
+    _Alignas(64) _Atomic uint64_t head; /* events published; written by the producer only */
+    _Atomic uint32_t wake;              /* futex word, bumped when sleepers are woken */
+    _Atomic uint32_t sleepers;          /* consumers inside eventbus_wait() */
+    _Alignas(64) _Atomic uint64_t dropped;
+    uint64_t mask;
+    EventSlot *slots;
+};
+
+/* --- Bus --- */
+EventBus *eventbus_new(uint32_t capacity) {
+    EventBus *bus;
+    uint64_t n = 1;
+
+    if (capacity == 0) capacity = EVENTBUS_DEFAULT_CAPACITY;
+    while (n < capacity) n <<= 1;
+    if (!(bus = aligned_alloc(64, sizeof(*bus)))) return NULL;
+    memset(bus, 0, sizeof(*bus));
+    if (!(bus->slots = aligned_alloc(64, n * sizeof(EventSlot)))) {
+        free(bus);
+        return NULL;
+    }
+    memset(bus->slots, 0, n * sizeof(EventSlot)); /* seq 0: never written */
+    bus->mask = n - 1;
+    return bus;
+}
+
+void eventbus_free(EventBus *bus) {
+    if (!bus) return;
+    free(bus->slots);
+    free(bus);
+}
+
+uint64_t eventbus_published(EventBus *bus) {
+    return atomic_load_explicit(&bus->head, memory_order_acquire);
+}
+
+uint64_t eventbus_dropped_subscribers(EventBus *bus) {
+    return atomic_load_explicit(&bus->dropped, memory_order_relaxed);
+}
+
+/* --- Producer --- */
+/* A per-slot seqlock: readers check the sequence before and after copying,
+ * so the producer can overwrite a slot someone is still reading and the
+ * reader finds out instead of the producer waiting for it */
+void eventbus_publish(EventBus *bus, MatchEvent *event) {
+    uint64_t p = atomic_load_explicit(&bus->head, memory_order_relaxed);
+    EventSlot *slot = &bus->slots[p & bus->mask];
+    uint64_t words[EVENT_WORDS];
+
+    event->seq = p;
+    memcpy(words, event, sizeof(words));
+    atomic_store_explicit(&slot->seq, 2 * p + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    for (size_t i = 0; i < EVENT_WORDS; i++) atomic_store_explicit(&slot->words[i], words[i], memory_order_relaxed);
+    atomic_store_explicit(&slot->seq, 2 * p + 2, memory_order_release);
+
+    /* No full fence here (it would double the cost of publishing): the
+     * sleepers load may pass the head store, and a consumer going to sleep
+     * just then is not woken. eventbus_wait() sleeps in WAIT_SLICE_NS
+     * slices, so that costs it at most one slice. */
+    atomic_store_explicit(&bus->head, p + 1, memory_order_release);
+    if (atomic_load_explicit(&bus->sleepers, memory_order_relaxed)) {
+        atomic_fetch_add_explicit(&bus->wake, 1, memory_order_release);
+        syscall(SYS_futex, (uint32_t *)&bus->wake, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+    }
+}
+
+/* --- Consumers --- */
+void eventbus_subscribe(EventBus *bus, EventSubscriber *sub) {
+    sub->bus = bus;
+    sub->cursor = atomic_load_explicit(&bus->head, memory_order_acquire);
+    sub->received = 0;
+    sub->dropped = 0;
+}
+
+static int drop(EventSubscriber *sub) {
+    if (!sub->dropped) atomic_fetch_add_explicit(&sub->bus->dropped, 1, memory_order_relaxed);
+    sub->dropped = 1;
+    return EVENTBUS_DROPPED;
+}
+
+int eventbus_poll(EventSubscriber *sub, MatchEvent *out) {
+    EventBus *bus = sub->bus;
+    uint64_t head, p = sub->cursor, before, after, words[EVENT_WORDS];
+    EventSlot *slot;
+
+    if (sub->dropped) return EVENTBUS_DROPPED;
+    head = atomic_load_explicit(&bus->head, memory_order_acquire);
+    if (head == p) return 0;
+    if (head - p > bus->mask + 1) return drop(sub); /* its slot was reused already */
+
+    slot = &bus->slots[p & bus->mask];
+    before = atomic_load_explicit(&slot->seq, memory_order_acquire);
+    for (size_t i = 0; i < EVENT_WORDS; i++) words[i] = atomic_load_explicit(&slot->words[i], memory_order_relaxed);
+    atomic_thread_fence(memory_order_acquire);
+    after = atomic_load_explicit(&slot->seq, memory_order_relaxed);
+    if (before != 2 * p + 2 || after != before) return drop(sub); /* lapped while copying */
+
+    memcpy(out, words, sizeof(*out));
+    sub->cursor = p + 1;
+    sub->received++;
+    return 1;
+}
+
+static int peek(EventSubscriber *sub) {
+    uint64_t head = atomic_load_explicit(&sub->bus->head, memory_order_acquire);
+
+    if (sub->dropped || head - sub->cursor > sub->bus->mask + 1) return EVENTBUS_DROPPED;
+    return head != sub->cursor;
+}
+
+int eventbus_wait(EventSubscriber *sub, int timeout_ms) {
+    EventBus *bus = sub->bus;
+    struct timespec now, deadline, left = { 0, WAIT_SLICE_NS };
+    int state;
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    if (timeout_ms >= 0) {
+        deadline.tv_sec += timeout_ms / 1000;
+        deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) deadline.tv_sec++, deadline.tv_nsec -= 1000000000L;
+    }
+    while ((state = peek(sub)) == 0) {
+        uint32_t wake;
+
+        if (timeout_ms >= 0) {
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            left.tv_sec = deadline.tv_sec - now.tv_sec;
+            left.tv_nsec = deadline.tv_nsec - now.tv_nsec;
+            if (left.tv_nsec < 0) left.tv_sec--, left.tv_nsec += 1000000000L;
+            if (left.tv_sec < 0) return 0;
+            if (left.tv_sec > 0 || left.tv_nsec > WAIT_SLICE_NS) left.tv_sec = 0, left.tv_nsec = WAIT_SLICE_NS;
+        }
+        atomic_fetch_add_explicit(&bus->sleepers, 1, memory_order_seq_cst);
+        wake = atomic_load_explicit(&bus->wake, memory_order_acquire);
+        if (peek(sub) == 0) /* still nothing now that the producer can see us */
+            syscall(SYS_futex, (uint32_t *)&bus->wake, FUTEX_WAIT_PRIVATE, wake, &left, NULL, 0);
+        atomic_fetch_sub_explicit(&bus->sleepers, 1, memory_order_relaxed);
+    }
+    return state;
+}
+
+/* --- Event log observer --- */
+struct EventLog {
+    EventBus *bus;
+    EventSubscriber sub;
+    OutBuf out;
+    int fd;
+    int failed;
+    _Atomic int stopping;
+    uint64_t stop_at;                   /* published count when asked to stop */
+    pthread_t thread;
+};
+
+static const char *const side_names[3] = { "draw", "player", "computer" };   /* by RESULT_* */
+
+static const char *move_label(const MatchEvent *e, int move) {
+    const RuleSet *r = rules_by_id(e->rules);
+    return (r && move >= 1 && move <= r->n_moves) ? r->labels[move] : "?";
+}
+
+/* Events are a few per second from a person playing, so plain snprintf */
+static int event_log_write(EventLog *log, const MatchEvent *e) {
+    char *p = outbuf_reserve(&log->out, 256);
+    int n;
+
+    if (!p) return -1;
+    if (e->type == EVENT_ROUND)
+        n = snprintf(p, 256, "{\"seq\":%llu,\"type\":\"round\",\"match\":%u,\"round\":%u,\"player_move\":\"%s\","
+                     "\"computer_move\":\"%s\",\"result\":\"%s\",\"player_score\":%u,\"computer_score\":%u}\n",
+                     (unsigned long long)e->seq, e->match, e->round, move_label(e, e->player_move),
+                     move_label(e, e->computer_move), side_names[e->result % 3], e->player_score, e->computer_score);
+    else
+        n = snprintf(p, 256, "{\"seq\":%llu,\"type\":\"match\",\"match\":%u,\"rounds\":%u,\"winner\":\"%s\","
+                     "\"player_score\":%u,\"computer_score\":%u}\n",
+                     (unsigned long long)e->seq, e->match, e->round, side_names[e->result % 3], e->player_score,
+                     e->computer_score);
+    outbuf_commit(&log->out, p + (n > 0 && n < 256 ? n : 0));
+    return 0;
+}
+
+static void *event_log_thread(void *arg) {
+    EventLog *log = arg;
+    MatchEvent e;
+
+    for (;;) {
+        int state = eventbus_wait(&log->sub, 100);
+
+        if (state == EVENTBUS_DROPPED) {
+            /* fell a whole ring behind (a stalled disk); say so and carry on from now */
+            uint64_t from = log->sub.cursor;
+            char *p = outbuf_reserve(&log->out, 64);
+
+            eventbus_subscribe(log->bus, &log->sub);
+            if (p) {
+                int n = snprintf(p, 64, "{\"type\":\"lost\",\"events\":%llu}\n",
+                                 (unsigned long long)(log->sub.cursor - from));
+                outbuf_commit(&log->out, p + (n > 0 && n < 64 ? n : 0));
+            }
+        }
+        while (eventbus_poll(&log->sub, &e) == 1)
+            if (event_log_write(log, &e) < 0) log->failed = 1;
+        if (log->out.len && outbuf_flush(&log->out) < 0) {
+            log->failed = 1;
+            log->out.len = 0; /* a reader that went away must not stop the bus being drained */
+        }
+        if (atomic_load_explicit(&log->stopping, memory_order_acquire) && log->sub.cursor >= log->stop_at) break;
+    }
+    return NULL;
+}
+
+EventLog *event_log_start(EventBus *bus, const char *path) {
+    EventLog *log = calloc(1, sizeof(*log));
+
+    if (!log) return NULL;
+    /* O_NONBLOCK so a FIFO with no reader yet fails here instead of hanging the caller */
+    if ((log->fd = open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC | O_NONBLOCK, 0644)) < 0) {
+        free(log);
+        return NULL;
+    }
+    fcntl(log->fd, F_SETFL, fcntl(log->fd, F_GETFL) & ~O_NONBLOCK);
+    if (outbuf_init(&log->out, log->fd, 64 * 1024) < 0) {
+        close(log->fd);
+        free(log);
+        errno = ENOMEM;
+        return NULL;
+    }
+    log->bus = bus;
+    eventbus_subscribe(bus, &log->sub);
+    if ((errno = pthread_create(&log->thread, NULL, event_log_thread, log)) != 0) {
+        outbuf_free(&log->out);
+        close(log->fd);
+        free(log);
+        return NULL;
+    }
+    return log;
+}
+
+int event_log_stop(EventLog *log) {
+    int status;
+
+    if (!log) return 0;
+    log->stop_at = eventbus_published(log->bus);
+    atomic_store_explicit(&log->stopping, 1, memory_order_release);
+    pthread_join(log->thread, NULL);
+    status = (log->failed || close(log->fd) < 0) ? -1 : 0;
+    if (log->failed) close(log->fd);
+    outbuf_free(&log->out);
+    free(log);
+    return status;
+}
@@ -0,0 +1,105 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Match event bus (GTK-free)
+ * ----------------------------------------------------------------------------
+ * NOTE: Round and match results are published as 32-byte MatchEvents into
+ * one ring buffer that any number of observers read independently:
+ * single producer, many consumers, no locks.
+ *
+ *   - The producer never waits for anyone. Each slot carries a sequence
+ *     number (odd while being written, even once done), so publishing is
+ *     a few plain stores, whatever the number of observers.
+ *   - Each subscriber owns its read cursor; the bus does not know how many
+ *     there are. A subscriber that falls a whole ring behind has lost
+ *     events it can never get back: it is dropped (eventbus_poll() returns
+ *     EVENTBUS_DROPPED from then on) and must subscribe again, starting
+ *     from the newest event.
+ *   - A reader that races the producer lapping it sees the slot sequence
+ *     change under it and is dropped the same way, so a torn event is
+ *     never returned.
+ *
+ * Consumers either poll (a GTK timeout, a game loop) or block in
+ * eventbus_wait(), which sleeps on a futex; the producer pays for the
+ * wake-up system call only while someone is actually asleep. (It does not
+ * fence against a consumer falling asleep at that very moment, which may
+ * then see the event up to 10 ms late.)
+ *
+ * RPS_EVENTS=<path> starts an EventLog: a thread that subscribes and
+ * writes every event as one JSON line to a file or FIFO.
+ */
+
+#ifndef RPS_EVENTBUS_H
+#define RPS_EVENTBUS_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#define EVENTBUS_DEFAULT_CAPACITY 4096   /* events; at most a few seconds of the fastest producer */
+#define EVENTBUS_DROPPED (-1)
+
+typedef enum {
+    EVENT_ROUND = 1,                /* one round was scored */
+    EVENT_MATCH                     /* a match ended; result is the winner */
+} MatchEventType;
+
+typedef struct {
+    uint64_t seq;                   /* position in the stream, set by the bus */
+    uint64_t time_ns;               /* wall clock, as in the match log */
+    uint32_t match;                 /* producer's match number */
+    uint8_t type;                   /* MatchEventType */
+    uint8_t round;                  /* 1-based; rounds played for EVENT_MATCH */
+    uint8_t player_move;            /* moves of the active rules, 0 for EVENT_MATCH */
+    uint8_t computer_move;
+    uint8_t result;                 /* RESULT_* of the round or the match */
+    uint8_t player_score;           /* scores after the round */
+    uint8_t computer_score;
+    uint8_t rules;                  /* RulesId */
+    uint32_t reserved;
+} MatchEvent;
+
+_Static_assert(sizeof(MatchEvent) == 32, "MatchEvent layout");
+
+typedef struct EventBus EventBus;
+
+/* A consumer's view of the bus; owned (and only touched) by that consumer */
+typedef struct {
+    EventBus *bus;
+    uint64_t cursor;                /* next position to read */
+    uint64_t received;
+    int dropped;
+} EventSubscriber;
+
+/* `capacity` is rounded up to a power of two; 0 means the default. NULL
+ * when out of memory. */
+EventBus *eventbus_new(uint32_t capacity);
+/* Every subscriber and the producer must be done with it */
+void eventbus_free(EventBus *bus);
+
+/* Producer side; one thread only. Fills event->seq. */
+void eventbus_publish(EventBus *bus, MatchEvent *event);
+
+/* Any thread: start reading at the next event published */
+void eventbus_subscribe(EventBus *bus, EventSubscriber *sub);
+/* 1 with the next event in `out`, 0 if there is none yet, or
+ * EVENTBUS_DROPPED once the subscriber fell a ring behind */
+int eventbus_poll(EventSubscriber *sub, MatchEvent *out);
+/* Block until an event is there, the subscriber was dropped, or
+ * `timeout_ms` (< 0: no limit) passed; returns what eventbus_poll() would
+ * see without consuming: 1, 0 or EVENTBUS_DROPPED */
+int eventbus_wait(EventSubscriber *sub, int timeout_ms);
+
+uint64_t eventbus_published(EventBus *bus);
+/* Subscribers dropped so far, counted when they notice */
+uint64_t eventbus_dropped_subscribers(EventBus *bus);
+
+/* --- Event log observer --- */
+typedef struct EventLog EventLog;
+
+/* Subscribes and writes JSON lines to `path` from a thread of its own;
+ * NULL with errno set if the file cannot be opened */
+EventLog *event_log_start(EventBus *bus, const char *path);
+/* Writes what was published before the call, then stops; -1 if a write failed */
+int event_log_stop(EventLog *log);
+
+#endif /* RPS_EVENTBUS_H */
@@ -0,0 +1,68 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Log-linear latency histogram
+ * ----------------------------------------------------------------------------
+ */
+
+#include <string.h>
+#include "histogram.h"
+
+void hist_init(Histogram *h) {
+    memset(h, 0, sizeof(*h));
+    h->min = UINT64_MAX;
+}
+
+void hist_merge(Histogram *into, const Histogram *from) {
+    for (int i = 0; i < HIST_BUCKETS; i++) into->counts[i] += from->counts[i];
+    into->total += from->total;
+    into->sum += from->sum;
+    if (from->min < into->min) into->min = from->min;
+    if (from->max > into->max) into->max = from->max;
+}
+
+/* Highest value that maps to bucket `index` */
+static uint64_t bucket_upper(int index) {
+    if (index < HIST_SUB_COUNT) return (uint64_t)index;
+    int rel = index - HIST_SUB_COUNT;
+    int e = rel / HIST_HALF_COUNT + HIST_SUB_BITS;
+    uint64_t top = (uint64_t)(rel % HIST_HALF_COUNT + HIST_HALF_COUNT);
+    int shift = e - (HIST_SUB_BITS - 1);
+    return ((top + 1) << shift) - 1;
+}
+
+/* Value at or below which `percentile` percent of samples fall (0..100) */
+uint64_t hist_percentile(const Histogram *h, double percentile) {
+    if (h->total == 0) return 0;
+    uint64_t rank = (uint64_t)((percentile / 100.0) * (double)h->total + 0.5);
+    uint64_t seen = 0;
+
+    if (rank == 0) rank = 1;
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        seen += h->counts[i];
+        if (seen >= rank) {
+            uint64_t v = bucket_upper(i);
+            return v > h->max ? h->max : v; /* never report above the true max */
+        }
+    }
+    return h->max;
+}
+
+double hist_mean(const Histogram *h) {
+    return h->total ? h->sum / (double)h->total : 0.0;
+}
+
+void hist_print(const Histogram *h, const char *label, const char *unit, double divisor, FILE *out) {
+    if (h->total == 0) {
+        fprintf(out, "%-14s no samples\n", label);
+        return;
+    }
+    fprintf(out, "%-14s n=%-10llu mean=%.2f%s p50=%.2f%s p90=%.2f%s p99=%.2f%s p99.9=%.2f%s max=%.2f%s\n",
+            label, (unsigned long long)h->total,
+            hist_mean(h) / divisor, unit,
+            (double)hist_percentile(h, 50.0) / divisor, unit,
+            (double)hist_percentile(h, 90.0) / divisor, unit,
+            (double)hist_percentile(h, 99.0) / divisor, unit,
+            (double)hist_percentile(h, 99.9) / divisor, unit,
+            (double)h->max / divisor, unit);
+}
@@ -0,0 +1,53 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Log-linear latency histogram (GTK-free)
+ * ----------------------------------------------------------------------------
+ * NOTE: HDR-style buckets: every power of two is split into 32 linear
+ * sub-buckets, so any recorded value is reported within ~3% over the full
+ * 64-bit range. Recording is a count-leading-zeros and an increment; no
+ * allocation, no locks. Keep one histogram per thread and merge them.
+ */
+
+#ifndef RPS_HISTOGRAM_H
+#define RPS_HISTOGRAM_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define HIST_SUB_BITS 6
+#define HIST_SUB_COUNT (1 << HIST_SUB_BITS)          /* exact buckets below this value */
+#define HIST_HALF_COUNT (HIST_SUB_COUNT / 2)          /* sub-buckets per power of two */
+#define HIST_BUCKETS (HIST_SUB_COUNT + (64 - HIST_SUB_BITS) * HIST_HALF_COUNT)
+
+typedef struct {
+    uint64_t counts[HIST_BUCKETS];
+    uint64_t total;
+    uint64_t min;
+    uint64_t max;
+    double sum;
+} Histogram;
+
+void hist_init(Histogram *h);
+void hist_merge(Histogram *into, const Histogram *from);
+uint64_t hist_percentile(const Histogram *h, double percentile);
+double hist_mean(const Histogram *h);
+/* one line: count, mean, p50/p90/p99/p99.9, max; values scaled by 1/divisor */
+void hist_print(const Histogram *h, const char *label, const char *unit, double divisor, FILE *out);
+
+static inline int hist_index(uint64_t value) {
+    if (value < HIST_SUB_COUNT) return (int)value;
+    int e = 63 - __builtin_clzll(value);                          /* >= HIST_SUB_BITS */
+    int top = (int)(value >> (e - (HIST_SUB_BITS - 1)));          /* HALF..SUB-1 */
+    return HIST_SUB_COUNT + (e - HIST_SUB_BITS) * HIST_HALF_COUNT + (top - HIST_HALF_COUNT);
+}
+
+static inline void hist_record(Histogram *h, uint64_t value) {
+    h->counts[hist_index(value)]++;
+    h->total++;
+    h->sum += (double)value;
+    if (value < h->min) h->min = value;
+    if (value > h->max) h->max = value;
+}
+
+#endif /* RPS_HISTOGRAM_H */
@@ -0,0 +1,616 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Persistent leaderboard
+ * ----------------------------------------------------------------------------
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <libgen.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "engine.h"
+#include "leaderboard.h"
+#include "matchlog.h"
+
+#define INITIAL_CAPACITY 1024
+#define INITIAL_FENWICK 64
+#define BATCH_INDEX_SIZE 2048            /* power of two over LEADERBOARD_JOURNAL_MAX */
+
+typedef struct Request Request;
+struct Request {
+    Request *next;
+    int result;                       /* RESULT_*, or -1 for a lookup */
+    LeaderboardFunc done;
+    void *user_data;
+    char name[LEADERBOARD_NAME_MAX + 1];
+};
+
+struct Leaderboard {
+    char *path;
+    int fd;
+    unsigned char *map;
+    size_t map_size;
+    LeaderboardHeader *header;
+    LeaderboardEntry *entries;
+    uint64_t mask;                    /* capacity - 1 */
+
+    /* rank index, worker-built; readers hold `lock` */
+    uint64_t *fenwick;                /* [1..fenwick_size], index wins + 1 */
+    uint64_t fenwick_size;            /* a power of two */
+    uint64_t top[LEADERBOARD_TOP_K];  /* slots, most wins first */
+    int n_top;
+
+    pthread_mutex_t lock;             /* entries as readers see them, the index, the queue */
+    pthread_cond_t wake;
+    pthread_cond_t idle;
+    Request *head, *tail;
+    int busy;                         /* worker holds a batch */
+    int loaded;                       /* index built */
+    int closing;
+    int error;
+    pthread_t thread;
+};
+
+/* A batch: the new contents of every slot it touches */
+typedef struct {
+    Request *requests[LEADERBOARD_JOURNAL_MAX];
+    uint64_t slots[LEADERBOARD_JOURNAL_MAX];     /* per request */
+    int n_requests;
+    LeaderboardJournalRecord records[LEADERBOARD_JOURNAL_MAX];
+    int n_records;
+    uint64_t new_players;
+    int16_t index[BATCH_INDEX_SIZE];             /* slot hash -> record + 1, 0 = free */
+} Batch;
+
+/* --- Names --- */
+static uint32_t name_hash(const char *s, size_t len) {
+    uint32_t h = 2166136261u; /* FNV-1a */
+    for (size_t i = 0; i < len; i++) h = (h ^ (unsigned char)s[i]) * 16777619u;
+    return h ? h : 1;
+}
+
+/* Copy at most LEADERBOARD_NAME_MAX bytes without splitting a UTF-8 sequence */
+static size_t name_copy(char *dst, const char *src) {
+    size_t len = strlen(src);
+
+    if (len > LEADERBOARD_NAME_MAX) {
+        len = LEADERBOARD_NAME_MAX;
+        while (len > 0 && ((unsigned char)src[len] & 0xc0) == 0x80) len--;
+    }
+    memcpy(dst, src, len);
+    memset(dst + len, 0, LEADERBOARD_NAME_MAX + 1 - len);
+    return len;
+}
+
+/* --- Rank index --- */
+static void fenwick_add(Leaderboard *lb, uint64_t wins, int64_t delta) {
+    uint64_t i = wins + 1;
+
+    while (i > lb->fenwick_size) {
+        /* doubling: the new top node covers everything so far, the rest of the new half is empty */
+        uint64_t n = lb->fenwick_size, *grown = realloc(lb->fenwick, (2 * n + 1) * sizeof(uint64_t));
+        if (!grown) {
+            lb->error = 1;
+            return;
+        }
+        memset(grown + n + 1, 0, n * sizeof(uint64_t));
+        grown[2 * n] = grown[n];
+        lb->fenwick = grown;
+        lb->fenwick_size = 2 * n;
+    }
+    for (; i <= lb->fenwick_size; i += i & (~i + 1)) lb->fenwick[i] += (uint64_t)delta;
+}
+
+/* Players with at most `wins` wins */
+static uint64_t fenwick_prefix(const Leaderboard *lb, uint64_t wins) {
+    uint64_t i = wins + 1, sum = 0;
+
+    if (i > lb->fenwick_size) i = lb->fenwick_size;
+    for (; i > 0; i -= i & (~i + 1)) sum += lb->fenwick[i];
+    return sum;
+}
+
+/* Slot `slot` gained wins (or is new): move it up the top list */
+static void top_update(Leaderboard *lb, uint64_t slot) {
+    uint32_t wins = lb->entries[slot].wins;
+    int pos;
+
+    for (pos = 0; pos < lb->n_top && lb->top[pos] != slot; pos++) {}
+    if (pos == lb->n_top) {
+        if (lb->n_top < LEADERBOARD_TOP_K) lb->n_top++;
+        else if (wins <= lb->entries[lb->top[LEADERBOARD_TOP_K - 1]].wins) return;
+        pos = lb->n_top - 1;
+        lb->top[pos] = slot;
+    }
+    for (; pos > 0 && lb->entries[lb->top[pos - 1]].wins < wins; pos--) {
+        lb->top[pos] = lb->top[pos - 1];
+        lb->top[pos - 1] = slot;
+    }
+}
+
+static int index_build(Leaderboard *lb) {
+    uint64_t max_wins = 0;
+
+    for (uint64_t s = 0; s <= lb->mask; s++)
+        if (lb->entries[s].hash && lb->entries[s].wins > max_wins) max_wins = lb->entries[s].wins;
+    free(lb->fenwick);
+    for (lb->fenwick_size = INITIAL_FENWICK; lb->fenwick_size < max_wins + 1; lb->fenwick_size *= 2) {}
+    lb->fenwick = calloc(lb->fenwick_size + 1, sizeof(uint64_t));
+    if (!lb->fenwick) return -1;
+
+    lb->n_top = 0;
+    for (uint64_t s = 0; s <= lb->mask; s++) {
+        if (!lb->entries[s].hash) continue;
+        fenwick_add(lb, lb->entries[s].wins, 1);
+        top_update(lb, s);
+    }
+    return 0;
+}
+
+/* Caller holds `lock` */
+static void standing_fill(const Leaderboard *lb, const LeaderboardEntry *player, LeaderboardStanding *out) {
+    out->player = *player;
+    out->players = lb->header->count;
+    out->rank = 1 + out->players - fenwick_prefix(lb, player->wins);
+    out->n_top = lb->n_top;
+    for (int i = 0; i < lb->n_top; i++) out->top[i] = lb->entries[lb->top[i]];
+}
+
+/* --- Mapping --- */
+static int map_file(Leaderboard *lb, int fd, size_t size) {
+    void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if (map == MAP_FAILED) return -1;
+    lb->fd = fd;
+    lb->map = map;
+    lb->map_size = size;
+    lb->header = map;
+    lb->entries = (LeaderboardEntry *)(lb->map + LEADERBOARD_HEADER_SIZE);
+    lb->mask = lb->header->capacity - 1;
+    return 0;
+}
+
+static size_t file_size(uint64_t capacity) {
+    return LEADERBOARD_HEADER_SIZE + (size_t)capacity * sizeof(LeaderboardEntry);
+}
+
+static int fsync_dir(const char *path) {
+    char *copy = strdup(path);
+    int fd, rc = -1;
+
+    if (!copy) return -1;
+    fd = open(dirname(copy), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0) {
+        rc = fsync(fd);
+        close(fd);
+    }
+    free(copy);
+    return rc;
+}
+
+/* A fresh, empty table of `capacity` slots at `path`, synced */
+static int create_file(const char *path, uint64_t capacity, int *fd_out) {
+    LeaderboardHeader header;
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+    if (fd < 0) return -1;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, LEADERBOARD_MAGIC, sizeof(LEADERBOARD_MAGIC));
+    header.version = LEADERBOARD_VERSION;
+    header.entry_size = sizeof(LeaderboardEntry);
+    header.capacity = capacity;
+    if (ftruncate(fd, (off_t)file_size(capacity)) < 0 || pwrite(fd, &header, sizeof(header), 0) != sizeof(header)) {
+        close(fd);
+        return -1;
+    }
+    *fd_out = fd;
+    return 0;
+}
+
+/* --- Journal --- */
+static uint32_t journal_crc(const LeaderboardHeader *h, uint32_t count) {
+    uint32_t crc = matchlog_crc32c(0, &count, sizeof(count));
+    crc = matchlog_crc32c(crc, &h->journal_player_count, sizeof(h->journal_player_count));
+    return matchlog_crc32c(crc, h->journal, count * sizeof(LeaderboardJournalRecord));
+}
+
+static int sync_range(Leaderboard *lb, size_t begin, size_t end) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    begin &= ~(page - 1);
+    return msync(lb->map + begin, end - begin, MS_SYNC);
+}
+
+/* Write the journal's records into the entries (at open, before the worker starts) */
+static void journal_apply(Leaderboard *lb) {
+    LeaderboardHeader *h = lb->header;
+
+    for (uint32_t i = 0; i < h->journal_count; i++) lb->entries[h->journal[i].slot] = h->journal[i].entry;
+    h->count = h->journal_player_count;
+}
+
+/* Replay an unfinished journal at open */
+static int journal_recover(Leaderboard *lb) {
+    LeaderboardHeader *h = lb->header;
+
+    if (h->journal_count == 0) return 0;
+    if (h->journal_count <= LEADERBOARD_JOURNAL_MAX && h->journal_crc == journal_crc(h, h->journal_count)) {
+        for (uint32_t i = 0; i < h->journal_count; i++)
+            if (h->journal[i].slot > lb->mask) return -1;
+        journal_apply(lb);
+        if (msync(lb->map, lb->map_size, MS_SYNC) < 0) return -1;
+    }
+    h->journal_count = 0; /* a torn journal was never acted on */
+    return msync(lb->map, LEADERBOARD_HEADER_SIZE, MS_SYNC);
+}
+
+/* --- Growing --- */
+/* Rehash into a file twice the size, then rename it over the old one;
+ * a crash at any point leaves one complete table at `path` */
+static int grow(Leaderboard *lb) {
+    char *tmp_path;
+    uint64_t capacity = (lb->mask + 1) * 2;
+    unsigned char *map;
+    LeaderboardEntry *entries;
+    int fd;
+
+    if (asprintf(&tmp_path, "%s.tmp", lb->path) < 0) return -1;
+    if (create_file(tmp_path, capacity, &fd) < 0) {
+        free(tmp_path);
+        return -1;
+    }
+    map = mmap(NULL, file_size(capacity), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) goto fail;
+    entries = (LeaderboardEntry *)(map + LEADERBOARD_HEADER_SIZE);
+    for (uint64_t s = 0; s <= lb->mask; s++) {
+        uint64_t i;
+        if (!lb->entries[s].hash) continue;
+        for (i = lb->entries[s].hash & (capacity - 1); entries[i].hash; i = (i + 1) & (capacity - 1)) {}
+        entries[i] = lb->entries[s];
+    }
+    ((LeaderboardHeader *)map)->count = lb->header->count;
+    if (msync(map, file_size(capacity), MS_SYNC) < 0 || rename(tmp_path, lb->path) < 0) {
+        munmap(map, file_size(capacity));
+        goto fail;
+    }
+    fsync_dir(lb->path);
+    free(tmp_path);
+
+    pthread_mutex_lock(&lb->lock);
+    munmap(lb->map, lb->map_size);
+    close(lb->fd);
+    lb->fd = fd;
+    lb->map = map;
+    lb->map_size = file_size(capacity);
+    lb->header = (LeaderboardHeader *)map;
+    lb->entries = entries;
+    lb->mask = capacity - 1;
+    index_build(lb); /* the top list holds slot numbers */
+    pthread_mutex_unlock(&lb->lock);
+    return 0;
+
+fail:
+    close(fd);
+    unlink(tmp_path);
+    free(tmp_path);
+    return -1;
+}
+
+/* --- Worker --- */
+/* Position of `slot` in the batch's index: its record, or the free cell for it */
+static int batch_find(const Batch *b, uint64_t slot) {
+    int i = (int)(slot & (BATCH_INDEX_SIZE - 1));
+
+    while (b->index[i] && b->records[b->index[i] - 1].slot != slot) i = (i + 1) & (BATCH_INDEX_SIZE - 1);
+    return i;
+}
+
+/* The batch's pending copy of `slot`, or the table's */
+static LeaderboardEntry *batch_entry(Leaderboard *lb, Batch *b, uint64_t slot) {
+    int i = batch_find(b, slot);
+    return b->index[i] ? &b->records[b->index[i] - 1].entry : &lb->entries[slot];
+}
+
+static LeaderboardEntry *batch_stage(Batch *b, uint64_t slot, const LeaderboardEntry *current) {
+    int i = batch_find(b, slot);
+
+    if (b->index[i]) return &b->records[b->index[i] - 1].entry;
+    b->records[b->n_records].slot = slot;
+    b->records[b->n_records].entry = *current;
+    b->index[i] = (int16_t)++b->n_records;
+    return &b->records[b->n_records - 1].entry;
+}
+
+/* Find (or, for an update, claim) the slot of a request's name */
+static uint64_t batch_plan(Leaderboard *lb, Batch *b, Request *r) {
+    size_t len = strlen(r->name);
+    uint32_t hash = name_hash(r->name, len);
+    uint64_t i = hash & lb->mask;
+    LeaderboardEntry *e;
+
+    for (;; i = (i + 1) & lb->mask) {
+        e = batch_entry(lb, b, i);
+        if (!e->hash) break;
+        if (e->hash == hash && memcmp(e->name, r->name, len + 1) == 0) break;
+    }
+    if (r->result < 0) return i;
+
+    e = batch_stage(b, i, e);
+    if (!e->hash) {
+        e->hash = hash;
+        memcpy(e->name, r->name, sizeof(e->name));
+        b->new_players++;
+    }
+    if (r->result == RESULT_PLAYER_WIN) e->wins++;
+    else if (r->result == RESULT_COMPUTER_WIN) e->losses++;
+    else e->draws++;
+    return i;
+}
+
+static void batch_run(Leaderboard *lb, Batch *b) {
+    LeaderboardHeader *h = lb->header;
+    size_t lo = lb->map_size, hi = 0;
+    int failed = 0;
+
+    /* keep the table at most 3/4 full, counting every name that might be new */
+    while ((h->count + (uint64_t)b->n_requests) * 4 > (lb->mask + 1) * 3) {
+        if (grow(lb) < 0) {
+            failed = 1;
+            break;
+        }
+        h = lb->header;
+    }
+
+    for (int i = 0; i < b->n_requests; i++) b->slots[i] = batch_plan(lb, b, b->requests[i]);
+
+    if (b->n_records > 0 && !failed) {
+        /* 1. journal, synced */
+        memcpy(h->journal, b->records, (size_t)b->n_records * sizeof(LeaderboardJournalRecord));
+        h->journal_player_count = h->count + b->new_players;
+        h->journal_crc = journal_crc(h, (uint32_t)b->n_records);
+        h->journal_count = (uint32_t)b->n_records;
+        failed = msync(lb->map, LEADERBOARD_HEADER_SIZE, MS_SYNC) < 0;
+    }
+    if (b->n_records > 0 && !failed) {
+        /* 2. entries and index, then the entries are synced */
+        pthread_mutex_lock(&lb->lock);
+        for (int i = 0; i < b->n_records; i++) {
+            uint64_t slot = b->records[i].slot;
+            const LeaderboardEntry *old = &lb->entries[slot];
+            const LeaderboardEntry *now = &b->records[i].entry;
+            size_t offset = LEADERBOARD_HEADER_SIZE + (size_t)slot * sizeof(LeaderboardEntry);
+
+            if (!old->hash) {
+                fenwick_add(lb, now->wins, 1);
+            } else if (old->wins != now->wins) {
+                fenwick_add(lb, old->wins, -1);
+                fenwick_add(lb, now->wins, 1);
+            }
+            if (offset < lo) lo = offset;
+            if (offset + sizeof(LeaderboardEntry) > hi) hi = offset + sizeof(LeaderboardEntry);
+            lb->entries[slot] = *now;
+            top_update(lb, slot); /* one at a time: the list stays sorted by what is applied */
+        }
+        h->count = h->journal_player_count;
+        pthread_mutex_unlock(&lb->lock);
+        failed = sync_range(lb, lo, hi) < 0;
+        /* 3. done with the journal; replaying it again would be harmless anyway */
+        if (!failed) h->journal_count = 0;
+    }
+
+    for (int i = 0; i < b->n_requests; i++) {
+        Request *r = b->requests[i];
+        if (r->done) {
+            LeaderboardStanding standing;
+            LeaderboardEntry unknown;
+
+            pthread_mutex_lock(&lb->lock);
+            if (lb->entries[b->slots[i]].hash) {
+                standing_fill(lb, &lb->entries[b->slots[i]], &standing);
+            } else {
+                memset(&unknown, 0, sizeof(unknown));
+                memcpy(unknown.name, r->name, sizeof(unknown.name));
+                standing_fill(lb, &unknown, &standing);
+            }
+            pthread_mutex_unlock(&lb->lock);
+            r->done(&standing, r->user_data);
+        }
+        free(r);
+    }
+    if (failed) {
+        pthread_mutex_lock(&lb->lock);
+        lb->error = 1;
+        pthread_mutex_unlock(&lb->lock);
+    }
+}
+
+static void *worker_main(void *arg) {
+    Leaderboard *lb = arg;
+    Batch *batch = malloc(sizeof(*batch));
+
+    pthread_mutex_lock(&lb->lock);
+    if (!batch || index_build(lb) < 0) lb->error = 1;
+    lb->loaded = 1;
+    pthread_cond_broadcast(&lb->idle);
+
+    for (;;) {
+        while (!lb->head && !lb->closing) pthread_cond_wait(&lb->wake, &lb->lock);
+        if (!lb->head || !batch) break; /* closing and drained */
+
+        batch->n_requests = batch->n_records = 0;
+        batch->new_players = 0;
+        memset(batch->index, 0, sizeof(batch->index));
+        while (lb->head && batch->n_requests < LEADERBOARD_JOURNAL_MAX) {
+            batch->requests[batch->n_requests++] = lb->head;
+            lb->head = lb->head->next;
+        }
+        if (!lb->head) lb->tail = NULL;
+        lb->busy = 1;
+        pthread_mutex_unlock(&lb->lock);
+
+        batch_run(lb, batch);
+
+        pthread_mutex_lock(&lb->lock);
+        lb->busy = 0;
+        if (!lb->head) pthread_cond_broadcast(&lb->idle);
+    }
+    pthread_mutex_unlock(&lb->lock);
+    free(batch);
+    return NULL;
+}
+
+/* --- Public API --- */
+Leaderboard *leaderboard_open(const char *path) {
+    Leaderboard *lb = calloc(1, sizeof(*lb));
+    LeaderboardHeader header;
+    struct stat st;
+    int fd = -1;
+
+    if (!lb || !(lb->path = strdup(path))) goto fail;
+    if (stat(path, &st) < 0) {
+        if (errno != ENOENT || create_file(path, INITIAL_CAPACITY, &fd) < 0 || fsync(fd) < 0) goto fail;
+        fsync_dir(path);
+    } else if ((fd = open(path, O_RDWR | O_CLOEXEC)) < 0) {
+        goto fail;
+    }
+    if (fstat(fd, &st) < 0) goto fail;
+    if (pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) ||
+        memcmp(header.magic, LEADERBOARD_MAGIC, sizeof(LEADERBOARD_MAGIC)) != 0 ||
+        header.version != LEADERBOARD_VERSION || header.entry_size != sizeof(LeaderboardEntry) ||
+        header.capacity == 0 || (header.capacity & (header.capacity - 1)) != 0 ||
+        (uint64_t)st.st_size < file_size(header.capacity)) {
+        errno = EINVAL;
+        goto fail;
+    }
+    if (map_file(lb, fd, file_size(header.capacity)) < 0) goto fail;
+    if (journal_recover(lb) < 0) goto fail_mapped;
+
+    pthread_mutex_init(&lb->lock, NULL);
+    pthread_cond_init(&lb->wake, NULL);
+    pthread_cond_init(&lb->idle, NULL);
+    if (pthread_create(&lb->thread, NULL, worker_main, lb) != 0) {
+        pthread_mutex_destroy(&lb->lock);
+        pthread_cond_destroy(&lb->wake);
+        pthread_cond_destroy(&lb->idle);
+        goto fail_mapped;
+    }
+    return lb;
+
+fail_mapped:
+    munmap(lb->map, lb->map_size);
+fail:
+    if (fd >= 0) close(fd);
+    if (lb) free(lb->path);
+    free(lb);
+    return NULL;
+}
+
+int leaderboard_close(Leaderboard *lb) {
+    int error;
+
+    if (!lb) return 0;
+    pthread_mutex_lock(&lb->lock);
+    lb->closing = 1;
+    pthread_cond_signal(&lb->wake);
+    pthread_mutex_unlock(&lb->lock);
+    pthread_join(lb->thread, NULL);
+
+    error = lb->error;
+    if (munmap(lb->map, lb->map_size) < 0 || close(lb->fd) < 0) error = 1;
+    pthread_mutex_destroy(&lb->lock);
+    pthread_cond_destroy(&lb->wake);
+    pthread_cond_destroy(&lb->idle);
+    free(lb->fenwick);
+    free(lb->path);
+    free(lb);
+    return error ? -1 : 0;
+}
+
+void leaderboard_submit(Leaderboard *lb, const char *name, int result, LeaderboardFunc done, void *user_data) {
+    Request *r = malloc(sizeof(*r));
+
+    if (!r) return;
+    r->next = NULL;
+    r->result = result;
+    r->done = done;
+    r->user_data = user_data;
+    name_copy(r->name, name);
+
+    pthread_mutex_lock(&lb->lock);
+    if (lb->tail) lb->tail->next = r;
+    else lb->head = r;
+    lb->tail = r;
+    pthread_cond_signal(&lb->wake);
+    pthread_mutex_unlock(&lb->lock);
+}
+
+void leaderboard_sync(Leaderboard *lb) {
+    pthread_mutex_lock(&lb->lock);
+    while (!lb->loaded || lb->head || lb->busy) pthread_cond_wait(&lb->idle, &lb->lock);
+    pthread_mutex_unlock(&lb->lock);
+}
+
+void leaderboard_lookup(Leaderboard *lb, const char *name, LeaderboardStanding *out) {
+    LeaderboardEntry key;
+    size_t len = name_copy(key.name, name);
+    uint64_t i;
+
+    memset(&key, 0, offsetof(LeaderboardEntry, name));
+    key.hash = name_hash(key.name, len);
+
+    pthread_mutex_lock(&lb->lock);
+    while (!lb->loaded) pthread_cond_wait(&lb->idle, &lb->lock);
+    for (i = key.hash & lb->mask; lb->entries[i].hash; i = (i + 1) & lb->mask) {
+        if (lb->entries[i].hash == key.hash && memcmp(lb->entries[i].name, key.name, len + 1) == 0) {
+            standing_fill(lb, &lb->entries[i], out);
+            pthread_mutex_unlock(&lb->lock);
+            return;
+        }
+    }
+    standing_fill(lb, &key, out);
+    pthread_mutex_unlock(&lb->lock);
+}
+
+/* mkdir -p: stops at the first level that cannot be made, so open() reports why */
+static void make_dirs(char *dir) {
+    for (char *p = dir + 1;; p++) {
+        if (*p != '/' && *p != '\0') continue;
+        char c = *p;
+        *p = '\0';
+        int failed = mkdir(dir, 0755) < 0 && errno != EEXIST;
+        *p = c;
+        if (failed || c == '\0') return;
+    }
+}
+
+char *leaderboard_default_path(void) {
+    const char *env = getenv("RPS_LEADERBOARD"), *base = getenv("XDG_DATA_HOME");
+    char *dir = NULL, *path = NULL;
+
+    if (env) return *env ? strdup(env) : NULL;
+    if (base && *base) {
+        if (asprintf(&dir, "%s/rps", base) < 0) return NULL;
+    } else {
+        const char *home = getenv("HOME");
+        if (asprintf(&dir, "%s/.local/share/rps", home ? home : ".") < 0) return NULL;
+    }
+    make_dirs(dir); /* a fresh home may lack ~/.local/share as well */
+    if (asprintf(&path, "%s/leaderboard.db", dir) < 0) path = NULL;
+    free(dir);
+    return path;
+}
+
+uint64_t leaderboard_players(Leaderboard *lb) {
+    uint64_t count;
+    pthread_mutex_lock(&lb->lock);
+    count = lb->header->count;
+    pthread_mutex_unlock(&lb->lock);
+    return count;
+}
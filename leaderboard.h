@@ -0,0 +1,111 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Persistent leaderboard (GTK-free)
+ * ----------------------------------------------------------------------------
+ * NOTE: Wins, losses and draws per player name, kept in one memory-mapped
+ * file. All integers are little-endian:
+ *
+ *   LeaderboardHeader + redo journal     LEADERBOARD_HEADER_SIZE bytes
+ *   LeaderboardEntry[capacity]           64 bytes each
+ *
+ * The entries are an open-addressing hash table (linear probing, at most
+ * 3/4 full), so finding a name is one or two cache lines whatever the
+ * size. When it fills up, a table twice the size is written to a new file
+ * and renamed over the old one.
+ *
+ * Crash safety: a batch of updates is first written to the redo journal
+ * in the header area (with a CRC-32C) and synced; only then are the
+ * entries changed and synced, and the journal cleared. On open, a journal
+ * with a good CRC is applied again, which is harmless if it had been
+ * applied already; one with a bad CRC was never acted on and is dropped.
+ *
+ * Ranks: players are ranked by wins. A Fenwick tree over win counts gives
+ * "how many players have more wins" in O(log max_wins), and the top
+ * LEADERBOARD_TOP_K players are kept sorted as entries change (wins only
+ * ever go up, so that list never needs a rescan). Both live only in
+ * memory and are rebuilt from the entries when the file is opened.
+ *
+ * One worker thread owns all updates and all disk I/O; callers queue
+ * requests and get the result through a callback on that thread, so a GUI
+ * never waits on the disk or on the lock.
+ */
+
+#ifndef RPS_LEADERBOARD_H
+#define RPS_LEADERBOARD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define LEADERBOARD_MAGIC "RPSLBRD"
+#define LEADERBOARD_VERSION 1
+#define LEADERBOARD_NAME_MAX 47       /* bytes; longer names are cut at a UTF-8 boundary */
+#define LEADERBOARD_TOP_K 10
+#define LEADERBOARD_HEADER_SIZE 65536
+#define LEADERBOARD_JOURNAL_MAX 900   /* records per batch, i.e. per pair of syncs */
+
+typedef struct {
+    uint32_t hash;                    /* of the name, never 0; 0 marks an empty slot */
+    uint32_t wins;
+    uint32_t losses;
+    uint32_t draws;
+    char name[LEADERBOARD_NAME_MAX + 1];
+} LeaderboardEntry;
+
+typedef struct {
+    uint64_t slot;
+    LeaderboardEntry entry;           /* the slot's new contents */
+} LeaderboardJournalRecord;
+
+typedef struct {
+    char magic[8];                    /* LEADERBOARD_MAGIC, NUL-padded */
+    uint16_t version;
+    uint16_t entry_size;              /* sizeof(LeaderboardEntry) */
+    uint32_t journal_count;           /* records to replay, 0 = none */
+    uint64_t capacity;                /* entry slots, a power of two */
+    uint64_t count;                   /* players stored */
+    uint64_t journal_player_count;    /* `count` once the journal is applied */
+    uint32_t journal_crc;             /* CRC-32C of journal_count, journal_player_count and the records */
+    uint32_t reserved;
+    LeaderboardJournalRecord journal[LEADERBOARD_JOURNAL_MAX];
+} LeaderboardHeader;
+
+_Static_assert(sizeof(LeaderboardEntry) == 64, "LeaderboardEntry layout");
+_Static_assert(sizeof(LeaderboardHeader) <= LEADERBOARD_HEADER_SIZE, "journal fits the header area");
+
+typedef struct {
+    LeaderboardEntry player;          /* all zero counts for an unknown name */
+    uint64_t rank;                    /* 1 + players with more wins */
+    uint64_t players;
+    int n_top;
+    LeaderboardEntry top[LEADERBOARD_TOP_K];   /* most wins first */
+} LeaderboardStanding;
+
+typedef struct Leaderboard Leaderboard;
+
+/* Called on the worker thread once the update is on disk */
+typedef void (*LeaderboardFunc)(const LeaderboardStanding *standing, void *user_data);
+
+/* Opens or creates `path` and replays an unfinished journal; the rank
+ * index is built on the worker thread. NULL with errno set on failure
+ * (EINVAL: not a leaderboard file). */
+Leaderboard *leaderboard_open(const char *path);
+/* Finishes queued requests, then closes; -1 if any write failed */
+int leaderboard_close(Leaderboard *lb);
+
+/* Queue one match result (RESULT_* from the player's side), or -1 for a
+ * plain lookup. Never blocks on I/O; `done` may be NULL. */
+void leaderboard_submit(Leaderboard *lb, const char *name, int result, LeaderboardFunc done, void *user_data);
+/* Wait until everything queued so far is on disk */
+void leaderboard_sync(Leaderboard *lb);
+
+/* RPS_LEADERBOARD, else $XDG_DATA_HOME/rps/leaderboard.db (~/.local/share
+ * when unset), creating the directory; malloc'd. NULL when RPS_LEADERBOARD
+ * is set but empty: no leaderboard. */
+char *leaderboard_default_path(void);
+
+/* Synchronous reads for tools (they wait for the rank index) */
+void leaderboard_lookup(Leaderboard *lb, const char *name, LeaderboardStanding *out);
+uint64_t leaderboard_players(Leaderboard *lb);
+
+#endif /* RPS_LEADERBOARD_H */
@@ -7,209 +7,490 @@
  * ----------------------------------------------------------------------------
  * NOTE: This file implements a Rock-Paper-Scissors GUI using GTK4.
  * Short comments were added throughout for readability — code logic remains unchanged.
+ * Build: glib-compile-resources --sourcedir=resources --generate-source --target=rps-resources.c resources/rps.gresource.xml
+ *        gcc main.c viewmodel.c netclient.c rps-resources.c analytics.c engine.c strategy.c rules.c rng.c outcome.c session.c pool.c matchlog.c trace.c histogram.c render.c driver.c bots.c outbuf.c leaderboard.c eventbus.c $(pkg-config --cflags --libs gtk4) -lm -o rps
  */
 
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
 #include <gtk/gtk.h>
-
-/* --- Game Constants --- */
-#define CHOICE_ROCK 1
-#define CHOICE_PAPER 2
-#define CHOICE_SCISSORS 3
-#define TOTAL_ROUNDS 3
+#include "analytics.h"
+#include "bots.h"
+#include "driver.h"
+#include "engine.h"
+#include "leaderboard.h"
+#include "eventbus.h"
+#include "matchlog.h"
+#include "netclient.h"
+#include "render.h"
+#include "rules.h"
+#include "session.h"
+#include "trace.h"
+#include "viewmodel.h"
+
+/* --- View-model slots (see viewmodel.h) --- */
+enum {
+    SLOT_NAME_ERROR,
+    SLOT_ROUND,
+    SLOT_SCORE,
+    SLOT_FEEDBACK,
+    SLOT_RESULT,
+    SLOT_CHOICES,
+    SLOT_NEXT_ROUND,
+    SLOT_FINAL_OUTCOME,
+    SLOT_FINAL_SCORE,
+    SLOT_RANK,
+    SLOT_STATS,
+    SLOT_COUNT
+};
+
+#define PLAYER_NAME_MAX 49
+#define RESULTS_DELAY_MS 350    /* long enough to read the deciding round */
+
+/* from the deciding round to the result screen; RPS_RESULTS_DELAY_MS,
+ * 0 shows the results at once */
+static guint results_delay_ms = RESULTS_DELAY_MS;
+
+/* every name entered this run, stored once however many games are played */
+static NameTable player_names;
+
+/* wins/losses/draws per name across runs (see leaderboard.h); NULL if unavailable */
+static Leaderboard *leaderboard;
+
+/* every round and match result, for observers (see eventbus.h); published
+ * from the main thread only */
+static EventBus *match_events;
+static EventLog *event_log;     /* RPS_EVENTS=<path> */
 
 /* --- Data Structure --- */
 typedef struct {
     GtkWidget *window; 
-    int current_round;          /* current round index (1-based) */
-    int player_score;          /* player cumulative score */
-    int computer_score;        /* computer cumulative score */
-    char player_name[50];      /* stored player name from login */
+    GameState game;            /* round/score state, owned by the engine */
+    Strategy *opponent;        /* computer player (see strategy.h) */
+    NetClient *net;            /* set when RPS_SERVER is set: the server picks the computer's move */
+    int pending_choice;        /* player's move while the computer's is computed or awaited from the server */
+    GCancellable *move_cancel; /* the computer's move in flight on a worker thread, NULL if none */
+    guint results_timeout_id;  /* pending on_show_final_results(), 0 if none */
+    MatchLogWriter *match_log; /* set when RPS_MATCH_LOG is set: every round is appended */
+    uint32_t session_id;       /* current match, as recorded in the log */
+    Analytics stats;           /* running statistics over every round this run */
+    const char *player_name;   /* interned in player_names, NULL before login */
 
     GtkWidget *stack;          /* main UI stack with screens */
+    ViewModel vm;              /* pending widget updates, flushed once per frame */
 
     /* Screen 1 (Login) */
     GtkWidget *name_entry;     /* entry widget for player's name */
     GtkWidget *name_error_label; /* label to show validation error */
+    GtkWidget *start_btn;      /* "Let's Battle!" */
 
     /* Screen 2 (Game) */
     GtkWidget *round_label;    /* label showing current round */
     GtkWidget *score_label;    /* label showing live scores */
     GtkWidget *feedback_label; /* label showing last choices */
     GtkWidget *result_label;   /* label showing round result (win/lose/draw) */
-    GtkWidget *choices_box;    /* container for rock/paper/scissor buttons */
+    GtkWidget *choices_box;    /* container for one button per move of the active rules */
+    GtkWidget *choice_icons[RULES_MAX_MOVES]; /* emoji label or pre-rasterised picture (see render.h) */
     GtkWidget *next_round_btn; /* button to proceed to next round */
 
     /* Screen 3 (Result) */
     GtkWidget *final_outcome_label; /* large label for final winner */
     GtkWidget *final_score_label;   /* final score display */
+    GtkWidget *rank_label;          /* leaderboard standing, filled in when the worker answers */
+    GtkWidget *stats_label;         /* running statistics panel */
     GtkWidget *play_again_btn;      /* restart game button */
 } AppData;
 
+/* window whose result screen shows leaderboard answers, NULL once it is gone */
+static AppData *leaderboard_view;
+
 /* --- Forward Declarations --- */
 static void start_new_game(AppData *data);
 static void start_next_round_ui(AppData *data);
 static void process_round(AppData *data, int user_choice);
+static void show_screen(AppData *data, const char *name);
+GtkWidget* create_game_screen(AppData *data);
+GtkWidget* create_result_screen(AppData *data);
+void activate(GtkApplication *app, gpointer user_data);
+
+/* --- Startup timing --- */
+/* Set RPS_STARTUP_TIME=1 to print the time from main() to the first painted
+ * frame; RPS_EXIT_AFTER_FIRST_FRAME=1 quits right after it (for scripted runs). */
+static gint64 startup_begin_us = 0;
 
 /* --- Helpers --- */
+/* Build the game/result screens the first time they are needed; only the
+ * name screen exists at startup. */
+static void ensure_screen(AppData *data, const char *name) {
+    if (gtk_stack_get_child_by_name(GTK_STACK(data->stack), name)) return;
+
+    if (strcmp(name, "game_screen") == 0)
+        gtk_stack_add_named(GTK_STACK(data->stack), create_game_screen(data), name);
+    else if (strcmp(name, "result_screen") == 0)
+        gtk_stack_add_named(GTK_STACK(data->stack), create_result_screen(data), name);
+}
+
+static gboolean screen_is(AppData *data, const char *name) {
+    return g_strcmp0(gtk_stack_get_visible_child_name(GTK_STACK(data->stack)), name) == 0;
+}
+
+/* Switch the stack to a screen, building it on first use */
+static void show_screen(AppData *data, const char *name) {
+    ensure_screen(data, name);
+    gtk_stack_set_visible_child_name(GTK_STACK(data->stack), name);
+}
+
 /* Update the score label text using current names and scores */
 void update_score_display(AppData *data) {
-    char *text = g_strdup_printf("%s: %d  |  Computer: %d",
-                                  data->player_name[0] ? data->player_name : "Player",
-                                  data->player_score, data->computer_score);
-    gtk_label_set_text(GTK_LABEL(data->score_label), text);
-    g_free(text);
+    vm_set_textf(&data->vm, SLOT_SCORE, "%s: %d  |  Computer: %d",
+                 data->player_name ? data->player_name : "Player",
+                 data->game.player_score, data->game.computer_score);
 }
 
 /* Update the round header label depending on current round */
 void update_round_display(AppData *data) {
-    char *text;
-    if (data->current_round <= TOTAL_ROUNDS) {
-        text = g_strdup_printf("Round %d: Fight!", data->current_round);
+    char spec[64];
+
+    if (!game_is_over(&data->game)) {
+        /* the format as RPS_FORMAT spells it; nothing for the default */
+        match_format_spec(&match_format, spec, sizeof(spec));
+        if (strcmp(spec, "best-of-" G_STRINGIFY(TOTAL_ROUNDS)) == 0)
+            vm_set_textf(&data->vm, SLOT_ROUND, "Round %d: Fight!", data->game.current_round);
+        else
+            vm_set_textf(&data->vm, SLOT_ROUND, "Round %d: Fight!  (%s)", data->game.current_round, spec);
     } else {
         /* when rounds are over show a calculating message */
-        text = g_strdup("Calculating Results...");
+        vm_set_text(&data->vm, SLOT_ROUND, "Calculating Results...");
     }
-    gtk_label_set_text(GTK_LABEL(data->round_label), text);
-    g_free(text);
+}
+
+/* "✊ 40%  ✋ 35%  ✌️ 25%" for the statistics panel */
+static void format_move_shares(char *out, size_t size, const uint64_t *counts) {
+    uint64_t n = 0;
+    size_t len = 0;
+
+    for (int m = 1; m <= rules->n_moves; m++) n += counts[m - 1];
+    out[0] = '\0';
+    for (int m = 1; m <= rules->n_moves && len < size; m++) {
+        double share = n ? 100.0 * (double)counts[m - 1] / (double)n : 0.0;
+        len += (size_t)g_snprintf(out + len, size - len, "%s%s %.0f%%", m > 1 ? "  " : "", rules->emoji[m], share);
+    }
+}
+
+/* Fill the results-screen statistics panel; reads counters only */
+static void update_stats_panel(AppData *data) {
+    Analytics *a = &data->stats;
+    char mine[96], theirs[96];
+
+    analytics_advance(a, (uint64_t)(g_get_monotonic_time() / G_USEC_PER_SEC)); /* idle time ages the hour view */
+    format_move_shares(mine, sizeof(mine), a->total.player_moves);
+    format_move_shares(theirs, sizeof(theirs), a->total.computer_moves);
+    vm_set_textf(&data->vm, SLOT_STATS,
+                 "Win rate: %.0f%% overall, %.0f%% last %d rounds, %.0f%% last hour\n"
+                 "Your moves: %s\n"
+                 "Computer: %s  (test vs uniform play: p=%.2f)\n"
+                 "Best streak: you %u, computer %u  |  Matches won: %llu of %llu",
+                 100.0 * analytics_rate(&a->total, RESULT_PLAYER_WIN),
+                 100.0 * analytics_rate(&a->recent, RESULT_PLAYER_WIN), ANALYTICS_RECENT_ROUNDS,
+                 100.0 * analytics_rate(&a->hour, RESULT_PLAYER_WIN),
+                 mine, theirs,
+                 analytics_uniformity(a->total.computer_moves, rules->n_moves, NULL),
+                 a->best_streak[RESULT_PLAYER_WIN], a->best_streak[RESULT_COMPUTER_WIN],
+                 (unsigned long long)a->match_results[RESULT_PLAYER_WIN], (unsigned long long)a->matches);
+}
+
+/* --- Match events --- */
+static void publish_event(AppData *data, int type, int user_choice, int computer_choice, int result) {
+    MatchEvent e;
+
+    if (!match_events) return;
+    memset(&e, 0, sizeof(e));
+    e.time_ns = matchlog_now_ns();
+    e.match = data->session_id;
+    e.type = (uint8_t)type;
+    e.round = (uint8_t)(data->game.current_round - 1); /* the engine has moved on to the next one */
+    e.player_move = (uint8_t)user_choice;
+    e.computer_move = (uint8_t)computer_choice;
+    e.result = (uint8_t)result;
+    e.player_score = (uint8_t)data->game.player_score;
+    e.computer_score = (uint8_t)data->game.computer_score;
+    e.rules = (uint8_t)rules->id;
+    eventbus_publish(match_events, &e);
+}
+
+/* --- Leaderboard --- */
+/* Main loop: show a standing the leaderboard worker sent */
+static gboolean on_leaderboard_standing_idle(gpointer user_data) {
+    LeaderboardStanding *s = user_data;
+    AppData *data = leaderboard_view;
+
+    /* the window may be gone, or already in the next match for another name */
+    if (data && data->player_name && strncmp(data->player_name, s->player.name, LEADERBOARD_NAME_MAX) == 0) {
+        if (s->n_top > 0)
+            vm_set_textf(&data->vm, SLOT_RANK, "Rank #%llu of %llu  |  %u W  %u L  %u D\nLeader: %s (%u wins)",
+                         (unsigned long long)s->rank, (unsigned long long)s->players, s->player.wins,
+                         s->player.losses, s->player.draws, s->top[0].name, s->top[0].wins);
+    }
+    g_free(s);
+    return G_SOURCE_REMOVE;
+}
+
+/* Leaderboard worker thread: hand the standing over to the main loop */
+static void on_leaderboard_standing(const LeaderboardStanding *standing, void *user_data) {
+    LeaderboardStanding *copy = g_new(LeaderboardStanding, 1);
+    (void)user_data;
+    *copy = *standing;
+    g_idle_add(on_leaderboard_standing_idle, copy);
 }
 
 /* Timer callback to compute and show final results -- runs in main loop */
 gboolean on_show_final_results(gpointer user_data) {
     AppData *data = (AppData *)user_data;
-    char *outcome_text;
-    char *score_text;
-
-    /* clear any previous CSS classes on the final label */
-    gtk_widget_remove_css_class(data->final_outcome_label, "success");
-    gtk_widget_remove_css_class(data->final_outcome_label, "error");
-    gtk_widget_remove_css_class(data->final_outcome_label, "warning");
-
-    /* Determine winner and set appropriate text and CSS class */
-    if (data->player_score > data->computer_score) {
-        outcome_text = g_strdup_printf("CHAMPION!\n%s wins!", data->player_name);
-        gtk_widget_add_css_class(data->final_outcome_label, "success");
-    } else if (data->computer_score > data->player_score) {
-        outcome_text = g_strdup("DEFEAT!\nThe Computer won.");
-        gtk_widget_add_css_class(data->final_outcome_label, "error");
-    } else {
-        outcome_text = g_strdup("DRAW GAME!");
-        gtk_widget_add_css_class(data->final_outcome_label, "warning");
-    }
 
-    score_text = g_strdup_printf("Final Score: %d - %d", data->player_score, data->computer_score);
+    data->results_timeout_id = 0;
+    ensure_screen(data, "result_screen");
 
-    /* update UI labels and switch to result screen */
-    gtk_label_set_text(GTK_LABEL(data->final_outcome_label), outcome_text);
-    gtk_label_set_text(GTK_LABEL(data->final_score_label), score_text);
+    /* Determine winner and set appropriate text and styling */
+    int winner = game_winner(&data->game);
+    analytics_record_match(&data->stats, winner);
+    publish_event(data, EVENT_MATCH, 0, 0, winner);
+    if (leaderboard && data->player_name) {
+        vm_set_text(&data->vm, SLOT_RANK, "Updating the leaderboard...");
+        leaderboard_submit(leaderboard, data->player_name, winner, on_leaderboard_standing, NULL);
+    }
+    if (winner == RESULT_PLAYER_WIN) {
+        vm_set_textf(&data->vm, SLOT_FINAL_OUTCOME, "CHAMPION!\n%s wins!", data->player_name);
+        vm_set_state(&data->vm, SLOT_FINAL_OUTCOME, VM_STATE_SUCCESS);
+    } else if (winner == RESULT_COMPUTER_WIN) {
+        vm_set_text(&data->vm, SLOT_FINAL_OUTCOME, "DEFEAT!\nThe Computer won.");
+        vm_set_state(&data->vm, SLOT_FINAL_OUTCOME, VM_STATE_ERROR);
+    } else {
+        vm_set_text(&data->vm, SLOT_FINAL_OUTCOME, "DRAW GAME!");
+        vm_set_state(&data->vm, SLOT_FINAL_OUTCOME, VM_STATE_WARNING);
+    }
 
-    g_free(outcome_text);
-    g_free(score_text);
+    vm_set_textf(&data->vm, SLOT_FINAL_SCORE, "Final Score: %d - %d", data->game.player_score, data->game.computer_score);
+    update_stats_panel(data);
 
-    gtk_stack_set_visible_child_name(GTK_STACK(data->stack), "result_screen");
+    /* switch to result screen; labels are pushed on the next frame tick */
+    show_screen(data, "result_screen");
+    TRACE_RESULT_SHOWN(GTK_STACK(data->stack));
     return G_SOURCE_REMOVE; /* stop the timeout source after running once */
 }
 
 /* --- Game Logic --- */
-/* Initialize and start a fresh game */
-void start_new_game(AppData *data) {
-    data->current_round = 1;
-    data->player_score = 0;
-    data->computer_score = 0;
-
-    /* reset feedback/result labels */
-    gtk_label_set_text(GTK_LABEL(data->feedback_label), "Make your move...");
-    gtk_label_set_text(GTK_LABEL(data->result_label), "");
-    
-    /* remove any previous result styling */
-    gtk_widget_remove_css_class(data->result_label, "success");
-    gtk_widget_remove_css_class(data->result_label, "error");
-    gtk_widget_remove_css_class(data->result_label, "warning");
+/* Reset the per-round widgets: prompt, no result, choices shown, next hidden */
+static void reset_round_widgets(AppData *data) {
+    vm_set_text(&data->vm, SLOT_FEEDBACK, "Make your move...");
+    vm_set_text(&data->vm, SLOT_RESULT, "");
+    vm_set_state(&data->vm, SLOT_RESULT, VM_STATE_NONE);
 
     update_round_display(data);
     update_score_display(data);
 
     /* make choices visible and hide next button until a round is played */
-    gtk_widget_set_visible(data->choices_box, TRUE);
-    gtk_widget_set_visible(data->next_round_btn, FALSE);
+    vm_set_visible(&data->vm, SLOT_CHOICES, TRUE);
+    vm_set_visible(&data->vm, SLOT_NEXT_ROUND, FALSE);
+}
+
+/* Drop a computer move still being computed and a pending results
+ * screen: both belong to the match that is being left */
+static void cancel_pending_round(AppData *data) {
+    if (data->move_cancel) {
+        g_cancellable_cancel(data->move_cancel);
+        g_clear_object(&data->move_cancel);
+    }
+    if (data->results_timeout_id) {
+        g_source_remove(data->results_timeout_id);
+        data->results_timeout_id = 0;
+    }
+    data->pending_choice = 0;
+    vm_set_state(&data->vm, SLOT_CHOICES, VM_STATE_NONE);
+}
+
+/* Initialize and start a fresh game */
+void start_new_game(AppData *data) {
+    cancel_pending_round(data);
+    game_reset(&data->game);
+    data->session_id++;
+    if (data->net) net_client_start_match(data->net, data->player_name);
+    ensure_screen(data, "game_screen");
+    reset_round_widgets(data);
 
     /* show the game screen in the stack */
-    gtk_stack_set_visible_child_name(GTK_STACK(data->stack), "game_screen");
+    show_screen(data, "game_screen");
 }
 
 /* Prepare UI for the next round (clears previous messages) */
 void start_next_round_ui(AppData *data) {
-    gtk_label_set_text(GTK_LABEL(data->feedback_label), "Make your move...");
-    gtk_label_set_text(GTK_LABEL(data->result_label), "");
-    
-    gtk_widget_remove_css_class(data->result_label, "success");
-    gtk_widget_remove_css_class(data->result_label, "error");
-    gtk_widget_remove_css_class(data->result_label, "warning");
-
-    update_round_display(data);
-    update_score_display(data);
+    reset_round_widgets(data);
+}
 
-    gtk_widget_set_visible(data->choices_box, TRUE);
-    gtk_widget_set_visible(data->next_round_btn, FALSE);
+/* The match is decided: results after a short pause (at once for the scripted driver) */
+static void schedule_final_results(AppData *data) {
+    TRACE_RESULT_PENDING();
+    data->results_timeout_id = (drive_enabled() || results_delay_ms == 0)
+                                   ? g_idle_add(on_show_final_results, data)
+                                   : g_timeout_add(results_delay_ms, on_show_final_results, data);
 }
 
-/* Process a single round: generate computer choice, decide winner, update UI */
-void process_round(AppData *data, int user_choice) {
-    int computer_choice = (rand() % 3) + 1; /* random int in 1..3 */
-    const char *user_str = (user_choice == 1) ? "ROCK" : (user_choice == 2) ? "PAPER" : "SCISSORS";
-    const char *comp_str = (computer_choice == 1) ? "ROCK" : (computer_choice == 2) ? "PAPER" : "SCISSORS";
-    int result = 0; /* 0 draw, 1 player win, 2 computer win */
-
-    /* compare choices to determine result and update scores */
-    if (user_choice == computer_choice) result = 0;
-    else if ((user_choice == 1 && computer_choice == 3) ||
-             (user_choice == 2 && computer_choice == 1) ||
-             (user_choice == 3 && computer_choice == 2)) {
-        result = 1;
-        data->player_score++;
-    } else {
-        result = 2;
-        data->computer_score++;
+/* Score a round whose two moves are known and update UI */
+static void apply_round(AppData *data, int user_choice, int computer_choice) {
+    int result = game_play_round(&data->game, user_choice, computer_choice); /* 0 draw, 1 player win, 2 computer win */
+
+    if (data->match_log) {
+        MatchLogRecord rec = { matchlog_now_ns(), data->session_id, (uint8_t)(data->game.current_round - 1),
+                               (uint8_t)user_choice, (uint8_t)computer_choice, (uint8_t)result };
+        matchlog_append(data->match_log, &rec); /* a memcpy; the disk write happens on another thread */
     }
+    analytics_record_round(&data->stats, user_choice, computer_choice, result,
+                           (uint64_t)(g_get_monotonic_time() / G_USEC_PER_SEC));
+    publish_event(data, EVENT_ROUND, user_choice, computer_choice, result);
 
     /* show which choices were made */
-    char *fb_text = g_strdup_printf("You: %s  vs  PC: %s", user_str, comp_str);
-    gtk_label_set_text(GTK_LABEL(data->feedback_label), fb_text);
-    g_free(fb_text);
-
-    /* clear old styling from the result label */
-    gtk_widget_remove_css_class(data->result_label, "success");
-    gtk_widget_remove_css_class(data->result_label, "error");
-    gtk_widget_remove_css_class(data->result_label, "warning");
+    vm_set_textf(&data->vm, SLOT_FEEDBACK, "You: %s  vs  PC: %s", choice_name(user_choice), choice_name(computer_choice));
 
     /* set round result text and styling */
-    if (result == 0) {
-        gtk_label_set_text(GTK_LABEL(data->result_label), "It's a Draw.");
-        gtk_widget_add_css_class(data->result_label, "warning");
-    } else if (result == 1) {
-        gtk_label_set_text(GTK_LABEL(data->result_label), "You Won!");
-        gtk_widget_add_css_class(data->result_label, "success");
+    if (result == RESULT_DRAW) {
+        vm_set_text(&data->vm, SLOT_RESULT, "It's a Draw.");
+        vm_set_state(&data->vm, SLOT_RESULT, VM_STATE_WARNING);
+    } else if (result == RESULT_PLAYER_WIN) {
+        vm_set_text(&data->vm, SLOT_RESULT, "You Won!");
+        vm_set_state(&data->vm, SLOT_RESULT, VM_STATE_SUCCESS);
     } else {
-        gtk_label_set_text(GTK_LABEL(data->result_label), "Computer Won.");
-        gtk_widget_add_css_class(data->result_label, "error");
+        vm_set_text(&data->vm, SLOT_RESULT, "Computer Won.");
+        vm_set_state(&data->vm, SLOT_RESULT, VM_STATE_ERROR);
     }
 
     update_score_display(data);
-    gtk_widget_set_visible(data->choices_box, FALSE); /* hide choice buttons after play */
+    vm_set_visible(&data->vm, SLOT_CHOICES, FALSE); /* hide choice buttons after play */
 
-    if (data->current_round < TOTAL_ROUNDS) {
-        data->current_round++;
-        gtk_button_set_label(GTK_BUTTON(data->next_round_btn), "Next Round ->");
-        gtk_widget_set_visible(data->next_round_btn, TRUE); /* show next button */
+    /* the engine ends the match as soon as it is decided, which may be before the format's last round */
+    if (!game_is_over(&data->game)) {
+        vm_set_text(&data->vm, SLOT_NEXT_ROUND, "Next Round ->");
+        vm_set_visible(&data->vm, SLOT_NEXT_ROUND, TRUE); /* show next button */
     } else {
-        /* increment once more so update_round_display() shows calculation state in callback */
-        data->current_round++;
-        /* schedule final result display after 1 second */
-        g_timeout_add_seconds(1, on_show_final_results, data);
+        schedule_final_results(data);
     }
+    TRACE_CALLBACK_DONE(); /* the click's round is done only now, the move came from a task */
+}
+
+/* --- Computer move on a worker thread --- */
+/* The task works on its own copy of the opponent, so a cancelled task
+ * still running can never race the next one; the copy replaces the
+ * opponent only when its move is used. */
+typedef struct {
+    StrategyStorage opponent;
+    int user_choice;
+    int computer_choice;
+} ComputerMove;
+
+static void computer_move_thread(GTask *task, gpointer source, gpointer task_data, GCancellable *cancellable) {
+    ComputerMove *move = task_data;
+    Strategy *opponent = &move->opponent.base;
+    (void)source; (void)cancellable;
+
+    move->computer_choice = opponent->choose(opponent);
+    if (opponent->observe) opponent->observe(opponent, move->computer_choice, move->user_choice);
+    g_task_return_boolean(task, TRUE);
+}
+
+/* Main loop again; the window (the task's source object) is still alive */
+static void on_computer_move_done(GObject *source, GAsyncResult *result, gpointer user_data) {
+    AppData *data = (AppData *)user_data;
+    ComputerMove *move = g_task_get_task_data(G_TASK(result));
+    GError *error = NULL;
+    (void)source;
+
+    if (!g_task_propagate_boolean(G_TASK(result), &error)) {
+        g_error_free(error); /* cancelled: Rematch, or the window closed */
+        return;
+    }
+    memcpy(data->opponent, &move->opponent, sizeof(move->opponent));
+    g_clear_object(&data->move_cancel);
+    data->pending_choice = 0;
+    vm_set_state(&data->vm, SLOT_CHOICES, VM_STATE_NONE);
+    apply_round(data, move->user_choice, move->computer_choice);
+}
+
+/* Process a single round: get the computer's move (on a worker thread, or
+ * from the server in network play), then score it */
+void process_round(AppData *data, int user_choice) {
+    data->pending_choice = user_choice; /* one move in flight at a time */
+    if (data->net) {
+        vm_set_visible(&data->vm, SLOT_CHOICES, FALSE);
+        vm_set_text(&data->vm, SLOT_FEEDBACK, "Waiting for the server...");
+        net_client_send_move(data->net, user_choice);
+        return;
+    }
+
+    ComputerMove *move = g_new(ComputerMove, 1);
+    memcpy(&move->opponent, data->opponent, sizeof(move->opponent)); /* strategy_new() allocates a StrategyStorage */
+    move->user_choice = user_choice;
+    move->computer_choice = 0;
+
+    vm_set_state(&data->vm, SLOT_CHOICES, VM_STATE_BUSY); /* locked, if the worker takes longer than a frame */
+    vm_set_text(&data->vm, SLOT_FEEDBACK, "The computer is thinking...");
+    data->move_cancel = g_cancellable_new();
+    GTask *task = g_task_new(data->window, data->move_cancel, on_computer_move_done, data);
+    g_task_set_task_data(task, move, g_free);
+    g_task_run_in_thread(task, computer_move_thread);
+    g_object_unref(task);
+}
+
+/* --- Network play --- */
+/* The server's match began: play it in the server's format */
+static void on_net_start(const MatchFormat *format, gpointer user_data) {
+    AppData *data = (AppData *)user_data;
+
+    match_format = *format;
+    if (data->game.current_round == 1) update_round_display(data);
+}
+
+/* Server answered our MOVE with its bot's move */
+static void on_net_round(int opponent_choice, gpointer user_data) {
+    AppData *data = (AppData *)user_data;
+    if (data->pending_choice == 0) return; /* stale reply */
+    int user_choice = data->pending_choice;
+    data->pending_choice = 0;
+    apply_round(data, user_choice, opponent_choice);
+}
+
+/* The server's word on how the match ended; only differs from ours if the
+ * two got out of step, and then it wins */
+static void on_net_match(int player_score, int opponent_score, gpointer user_data) {
+    AppData *data = (AppData *)user_data;
+    GameState *game = &data->game;
+
+    if (game_is_over(game) && game->player_score == player_score && game->computer_score == opponent_score) return;
+    g_printerr("rps: the server ended the match %d-%d, this game had %d-%d\n", player_score, opponent_score,
+               game->player_score, game->computer_score);
+    game->player_score = player_score;
+    game->computer_score = opponent_score;
+    update_score_display(data);
+    vm_set_visible(&data->vm, SLOT_CHOICES, FALSE);
+    vm_set_visible(&data->vm, SLOT_NEXT_ROUND, FALSE);
+    if (!data->results_timeout_id && !screen_is(data, "result_screen")) schedule_final_results(data);
+}
+
+/* Connection failed or dropped: finish the game against the local computer */
+static void on_net_error(const char *message, gpointer user_data) {
+    AppData *data = (AppData *)user_data;
+    char *text = g_strdup_printf("Server unavailable (%s), playing offline.", message);
+
+    g_printerr("rps: %s\n", text);
+    net_client_free(data->net);
+    data->net = NULL;
+    if (data->pending_choice) {
+        int user_choice = data->pending_choice;
+        data->pending_choice = 0;
+        process_round(data, user_choice);
+    } else {
+        vm_set_text(&data->vm, SLOT_FEEDBACK, text);
+    }
+    g_free(text);
 }
 
 /* --- Callbacks --- */
@@ -217,28 +498,37 @@ void process_round(AppData *data, int user_choice) {
 void on_start_clicked(GtkButton *btn, gpointer user_data) {
     AppData *data = (AppData *)user_data;
     char *name = NULL;
+    if (!screen_is(data, "name_screen")) return; /* second click before the game screen was up */
     g_object_get(G_OBJECT(data->name_entry), "text", &name, NULL);
 
     /* validate non-empty name */
     if (name == NULL || strlen(name) == 0) {
-        gtk_label_set_text(GTK_LABEL(data->name_error_label), "Hold on! Every hero needs a name!");
-        gtk_widget_set_visible(data->name_error_label, TRUE);
+        vm_set_text(&data->vm, SLOT_NAME_ERROR, "Hold on! Every hero needs a name!");
+        vm_set_visible(&data->vm, SLOT_NAME_ERROR, TRUE);
         if (name) g_free(name);
         return;
     }
-    /* copy safe into AppData and hide error */
-    g_strlcpy(data->player_name, name, sizeof(data->player_name));
-    gtk_widget_set_visible(data->name_error_label, FALSE);
+    /* intern (truncated) into player_names and hide error */
+    data->player_name = name_lookup(&player_names, name_intern(&player_names, name, PLAYER_NAME_MAX));
+    vm_set_visible(&data->vm, SLOT_NAME_ERROR, FALSE);
     g_free(name);
     start_new_game(data);
 }
 
-/* Simple wrappers connecting each choice button to process_round() */
-void on_rock_clicked(GtkButton *btn, gpointer user_data) { process_round((AppData*)user_data, CHOICE_ROCK); }
-void on_paper_clicked(GtkButton *btn, gpointer user_data) { process_round((AppData*)user_data, CHOICE_PAPER); }
-void on_scissors_clicked(GtkButton *btn, gpointer user_data) { process_round((AppData*)user_data, CHOICE_SCISSORS); }
+/* Every choice button lands here; the move is stored on the button. The
+ * buttons are only hidden on the next frame, so a double click can land
+ * twice: one move per round, the second is dropped. */
+void on_choice_button_clicked(GtkButton *btn, gpointer user_data) {
+    AppData *data = (AppData *)user_data;
+    if (!data->vm.slots[SLOT_CHOICES].want_visible || data->pending_choice) return;
+    TRACE_INPUT();
+    process_round(data, GPOINTER_TO_INT(g_object_get_data(G_OBJECT(btn), "rps-move")));
+}
 void on_next_round_clicked(GtkButton *btn, gpointer user_data) { start_next_round_ui((AppData*)user_data); }
-void on_play_again_clicked(GtkButton *btn, gpointer user_data) { start_new_game((AppData*)user_data); }
+void on_play_again_clicked(GtkButton *btn, gpointer user_data) {
+    AppData *data = (AppData *)user_data;
+    if (screen_is(data, "result_screen")) start_new_game(data); /* once per match, however fast the clicks */
+}
 
 /* Exit Callback - quits the application cleanly */
 void on_exit_clicked(GtkButton *btn, gpointer user_data) {
@@ -249,77 +539,69 @@ void on_exit_clicked(GtkButton *btn, gpointer user_data) {
 }
 
 /* --- CSS Styling --- */
-/* Loads application CSS into the GTK style context */
-void load_css(void) {
+/* Loads application CSS into the GTK style context. The stylesheet lives in
+ * resources/style.css and is compiled into the binary as a GResource, so
+ * startup only maps it instead of carrying a large C string around. */
+static void add_css_resource(const char *path, guint priority) {
     GtkCssProvider *provider = gtk_css_provider_new();
     GdkDisplay *display = gdk_display_get_default();
 
-    const char *css =
-        /* Main background - Grey */
-        ".window-bg { background-color: #cfcfcf; }"
-        
-        /* The White Card */
-        ".login-card { background-color: #ffffff; border-radius: 12px; padding: 30px; margin: 20px; box-shadow: 0px 4px 8px rgba(0,0,0,0.1); }"
-        
-        /* Typography */
-        ".game-title { font-size: 16pt; font-weight: bold; color: #4a00e0; margin-bottom: 5px; }"
-        ".welcome-text { font-size: 14pt; font-weight: bold; color: #2979ff; margin-bottom: 20px; }"
-        ".input-label { font-size: 11pt; color: #555555; margin-bottom: 5px; }"
-        ".round-header { font-size: 18pt; font-weight: bold; color: #6200ea; margin-bottom: 5px; }"
-        ".score-info { font-size: 10pt; color: #666666; margin-bottom: 15px; }"
-
-        /* Entry Field */
-        ".styled-entry { background: #ffffff; border: 1px solid #aaa; border-radius: 4px; padding: 10px; color: #000; }"
-        ".styled-entry:focus { border: 2px solid #2962ff; }"
-        
-        /* Added :focus and :active, and background-image: none */
-        "#start_btn { background-color: #1a237e; background-image: none; color: white; font-weight: bold; border-radius: 5px; padding: 10px; margin-top: 15px; }"
-        "#start_btn:hover { background-color: #2a3ed1ff; }"
-        "#start_btn:active { background-color: #1123ebff; box-shadow: inset 0 2px 4px rgba(0,0,0,0.2); }"
-        "#start_btn:focus { border: 2px solid #534bae; }"
-
-        /* Added :focus and :active, and background-image: none */
-        ".btn-exit { background-color: #d50000; background-image: none; color: white; font-weight: bold; font-size: 16px; border-radius: 5px; padding: 10px; margin-top: 15px; }"
-        ".btn-exit:hover { background-color: #b71c1c; }"
-        ".btn-exit:active { background-color: #d50000; box-shadow: inset 0 2px 4px rgba(0,0,0,0.2); }"
-        ".btn-exit:focus { border: 2px solid #ff5131; }"
-
-        /* Choice Buttons (Rock/Paper/Scissors) */
-        ".choice-btn { background-color: #f8f9fa; border: 1px solid #dee2e6; border-radius: 8px; padding: 10px; box-shadow: 0 2px 2px rgba(0,0,0,0.05); }"
-        ".choice-btn:hover { background-color: #e9ecef; border-color: #adb5bd; }"
-        ".choice-emoji { font-size: 36px; }"
-        ".choice-label { font-weight: bold; color: #333; font-size: 16px; margin-top: 5px; }"
-        
-        /* Footer Text */
-        ".footer-tip { font-size: 9pt; color: #888888; margin-top: 15px; }"
-        ".footer-credit { font-size: 8pt; color: #555555; margin-top: 5px; font-weight: bold; }"
-        
-        /* Game Screen Elements */
-        ".success { color: #00c853; font-weight: bold; font-size: 14pt; }"
-        ".error { color: #d50000; font-weight: bold; font-size: 11pt; }"
-        ".warning { color: #ffab00; font-weight: bold; font-size: 14pt; }";
-
-    gtk_css_provider_load_from_string(provider, css);
+    gtk_css_provider_load_from_resource(provider, path);
 
     if (display)
-        gtk_style_context_add_provider_for_display(display, GTK_STYLE_PROVIDER(provider), GTK_STYLE_PROVIDER_PRIORITY_USER);
+        gtk_style_context_add_provider_for_display(display, GTK_STYLE_PROVIDER(provider), priority);
     g_object_unref(provider);
 }
 
+/* Providers are per display, not per window: add them once however many
+ * windows are built */
+void load_css(void) {
+    static gboolean loaded = FALSE;
+    if (loaded) return;
+    loaded = TRUE;
+    add_css_resource("/com/example/rps/style.css", GTK_STYLE_PROVIDER_PRIORITY_USER);
+}
+
+/* Lite render profile: cheaper styles on top of the normal ones, no
+ * slide transition, and choice glyphs as cached textures */
+static void on_render_profile(RenderProfile profile, gpointer user_data) {
+    AppData *data = (AppData *)user_data;
+    static gboolean lite_css_loaded = FALSE;
+
+    if (profile != RENDER_LITE) return;
+    if (!lite_css_loaded)
+        add_css_resource("/com/example/rps/style-lite.css", GTK_STYLE_PROVIDER_PRIORITY_USER + 1);
+    lite_css_loaded = TRUE;
+    gtk_stack_set_transition_type(GTK_STACK(data->stack), GTK_STACK_TRANSITION_TYPE_NONE);
+
+    /* the game screen may already exist if the probe ran long */
+    for (int i = 0; i < RULES_MAX_MOVES; i++) {
+        GtkWidget *old = data->choice_icons[i];
+        if (!old || !GTK_IS_LABEL(old)) continue;
+        GtkWidget *box = gtk_widget_get_parent(old);
+        data->choice_icons[i] = render_choice_icon(data->window, gtk_label_get_text(GTK_LABEL(old)));
+        gtk_box_insert_child_after(GTK_BOX(box), data->choice_icons[i], old);
+        gtk_box_remove(GTK_BOX(box), old);
+    }
+}
+
 /* --- UI Construction --- */
 
-/* Helper to build a choice button with emoji + label */
-GtkWidget* create_choice_button(const char *emoji, const char *label_text, GCallback callback, AppData *data) {
+/* Helper to build the button for `move` of the active rules (emoji + label);
+ * *icon_out gets the emoji widget */
+GtkWidget* create_choice_button(int move, GCallback callback, AppData *data, GtkWidget **icon_out) {
     GtkWidget *btn = gtk_button_new();
     gtk_widget_add_css_class(btn, "choice-btn");
+    gtk_widget_set_size_request(btn, 80, 80);
+    g_object_set_data(G_OBJECT(btn), "rps-move", GINT_TO_POINTER(move));
     
     GtkWidget *box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 2);
     gtk_widget_set_halign(box, GTK_ALIGN_CENTER);
 
-    GtkWidget *lbl_emoji = gtk_label_new(emoji);
-    gtk_widget_add_css_class(lbl_emoji, "choice-emoji");
-    
-    GtkWidget *lbl_text = gtk_label_new(label_text);
+    GtkWidget *lbl_emoji = render_choice_icon(data->window, rules->emoji[move]); /* label, or a cached texture in lite mode */
+    *icon_out = lbl_emoji;
+
+    GtkWidget *lbl_text = gtk_label_new(rules->labels[move]);
     gtk_widget_add_css_class(lbl_text, "choice-label");
 
     gtk_box_append(GTK_BOX(box), lbl_emoji);
@@ -363,11 +645,11 @@ GtkWidget* create_name_screen(AppData *data) {
     gtk_widget_add_css_class(data->name_entry, "styled-entry");
     gtk_box_append(GTK_BOX(card), data->name_entry);
 
-    GtkWidget *btn = gtk_button_new_with_label("Let's Battle!");
-    gtk_widget_set_name(btn, "start_btn");
-    g_signal_connect(btn, "clicked", G_CALLBACK(on_start_clicked), data);
+    data->start_btn = gtk_button_new_with_label("Let's Battle!");
+    gtk_widget_set_name(data->start_btn, "start_btn");
+    g_signal_connect(data->start_btn, "clicked", G_CALLBACK(on_start_clicked), data);
     g_signal_connect(data->name_entry, "activate", G_CALLBACK(on_start_clicked), data);
-    gtk_box_append(GTK_BOX(card), btn);
+    gtk_box_append(GTK_BOX(card), data->start_btn);
 
     data->name_error_label = gtk_label_new("");
     gtk_widget_add_css_class(data->name_error_label, "error");
@@ -381,6 +663,7 @@ GtkWidget* create_name_screen(AppData *data) {
     gtk_widget_add_css_class(credit_lbl, "footer-credit");
     gtk_box_append(GTK_BOX(card), credit_lbl);
 
+    vm_bind(&data->vm, SLOT_NAME_ERROR, data->name_error_label, VM_KIND_LABEL);
     return center_box;
 }
 
@@ -418,18 +701,11 @@ GtkWidget* create_game_screen(AppData *data) {
     gtk_widget_set_halign(data->choices_box, GTK_ALIGN_CENTER);
     gtk_widget_set_margin_bottom(data->choices_box, 10);
 
-    /* Custom Buttons - USING EMOJIS */
-    GtkWidget *btn_rock = create_choice_button("✊", "Rock", G_CALLBACK(on_rock_clicked), data);
-    GtkWidget *btn_paper = create_choice_button("✋", "Paper", G_CALLBACK(on_paper_clicked), data);
-    GtkWidget *btn_scissors = create_choice_button("✌️", "Scissors", G_CALLBACK(on_scissors_clicked), data);
-    
-    gtk_widget_set_size_request(btn_rock, 80, 80);
-    gtk_widget_set_size_request(btn_paper, 80, 80);
-    gtk_widget_set_size_request(btn_scissors, 80, 80);
-
-    gtk_box_append(GTK_BOX(data->choices_box), btn_rock);
-    gtk_box_append(GTK_BOX(data->choices_box), btn_paper);
-    gtk_box_append(GTK_BOX(data->choices_box), btn_scissors);
+    /* Custom Buttons - USING EMOJIS, one per move in rule order (see rules.h) */
+    for (int m = 1; m <= rules->n_moves; m++) {
+        GtkWidget *btn = create_choice_button(m, G_CALLBACK(on_choice_button_clicked), data, &data->choice_icons[m - 1]);
+        gtk_box_append(GTK_BOX(data->choices_box), btn);
+    }
 
     gtk_box_append(GTK_BOX(card), data->choices_box);
 
@@ -439,12 +715,19 @@ GtkWidget* create_game_screen(AppData *data) {
     data->next_round_btn = gtk_button_new_with_label("Next");
     gtk_widget_set_name(data->next_round_btn, "start_btn");
     g_signal_connect(data->next_round_btn, "clicked", G_CALLBACK(on_next_round_clicked), data);
+    gtk_widget_set_visible(data->next_round_btn, FALSE); /* shown once a round is played */
     gtk_box_append(GTK_BOX(card), data->next_round_btn);
 
     GtkWidget *credit_lbl = gtk_label_new("Developed by SUJAY PAUL");
     gtk_widget_add_css_class(credit_lbl, "footer-credit");
     gtk_box_append(GTK_BOX(card), credit_lbl);
 
+    vm_bind(&data->vm, SLOT_ROUND, data->round_label, VM_KIND_LABEL);
+    vm_bind(&data->vm, SLOT_SCORE, data->score_label, VM_KIND_LABEL);
+    vm_bind(&data->vm, SLOT_FEEDBACK, data->feedback_label, VM_KIND_LABEL);
+    vm_bind(&data->vm, SLOT_RESULT, data->result_label, VM_KIND_LABEL);
+    vm_bind(&data->vm, SLOT_CHOICES, data->choices_box, VM_KIND_WIDGET);
+    vm_bind(&data->vm, SLOT_NEXT_ROUND, data->next_round_btn, VM_KIND_BUTTON);
     return center_box;
 }
 
@@ -474,6 +757,17 @@ GtkWidget* create_result_screen(AppData *data) {
     gtk_widget_set_halign(data->final_score_label, GTK_ALIGN_CENTER);
     gtk_box_append(GTK_BOX(card), data->final_score_label);
 
+    data->rank_label = gtk_label_new("");
+    gtk_label_set_justify(GTK_LABEL(data->rank_label), GTK_JUSTIFY_CENTER);
+    gtk_widget_set_halign(data->rank_label, GTK_ALIGN_CENTER);
+    gtk_box_append(GTK_BOX(card), data->rank_label);
+
+    data->stats_label = gtk_label_new("");
+    gtk_widget_add_css_class(data->stats_label, "stats-panel");
+    gtk_label_set_justify(GTK_LABEL(data->stats_label), GTK_JUSTIFY_CENTER);
+    gtk_widget_set_halign(data->stats_label, GTK_ALIGN_CENTER);
+    gtk_box_append(GTK_BOX(card), data->stats_label);
+
     /* --- SIDE BY SIDE BUTTONS CONTAINER --- */
     GtkWidget *button_box = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 10);
     gtk_widget_set_halign(button_box, GTK_ALIGN_CENTER);
@@ -501,19 +795,135 @@ GtkWidget* create_result_screen(AppData *data) {
     gtk_widget_add_css_class(credit_lbl, "footer-credit");
     gtk_box_append(GTK_BOX(card), credit_lbl);
 
+    vm_bind(&data->vm, SLOT_FINAL_OUTCOME, data->final_outcome_label, VM_KIND_LABEL);
+    vm_bind(&data->vm, SLOT_FINAL_SCORE, data->final_score_label, VM_KIND_LABEL);
+    vm_bind(&data->vm, SLOT_RANK, data->rank_label, VM_KIND_LABEL);
+    vm_bind(&data->vm, SLOT_STATS, data->stats_label, VM_KIND_LABEL);
     return vbox;
 }
 
+/* Write out whatever is still buffered when the window goes away, and
+ * drop everything that could call back into AppData */
+static void on_window_destroy(GtkWidget *window, gpointer user_data) {
+    AppData *data = (AppData *)user_data;
+    (void)window;
+    if (data->match_log && matchlog_writer_close(data->match_log) < 0)
+        g_printerr("match log: write failed, some rounds were not recorded\n");
+    data->match_log = NULL;
+    cancel_pending_round(data);
+    net_client_free(data->net);
+    data->net = NULL;
+    if (leaderboard_view == data) leaderboard_view = NULL;
+    trace_finish();
+}
+
+/* AppData lives as long as its window (set as the window's data) */
+static void free_app_data(gpointer user_data) {
+    AppData *data = (AppData *)user_data;
+    strategy_free(data->opponent);
+    g_free(data);
+}
+
+/* RPS_VM_STATS=1: report how many widget mutations the view-model skipped */
+static void on_window_destroy_stats(GtkWidget *window, gpointer user_data) {
+    (void)window;
+    vm_print_stats(&((AppData *)user_data)->vm, stderr);
+}
+
+/* Runs once, after the first frame has been painted */
+static void on_first_frame_painted(GdkFrameClock *clock, gpointer user_data) {
+    GtkWidget *window = GTK_WIDGET(user_data);
+    gint64 elapsed_us = g_get_monotonic_time() - startup_begin_us;
+
+    g_signal_handlers_disconnect_by_func(clock, G_CALLBACK(on_first_frame_painted), user_data);
+    if (g_getenv("RPS_STARTUP_TIME"))
+        g_printerr("startup: first frame painted %.2f ms after main()\n", elapsed_us / 1000.0);
+    if (g_getenv("RPS_EXIT_AFTER_FIRST_FRAME"))
+        g_application_quit(G_APPLICATION(gtk_window_get_application(GTK_WINDOW(window))));
+}
+
+/* --- Scripted driver (RPS_DRIVE, see driver.h) --- */
+/* What a user would click next, judged by what the next frame will show */
+static GtkWidget *drive_step(gpointer user_data, guint32 roll) {
+    AppData *data = (AppData *)user_data;
+
+    if (screen_is(data, "result_screen")) return data->play_again_btn;
+    if (!screen_is(data, "game_screen")) {
+        gtk_editable_set_text(GTK_EDITABLE(data->name_entry), "Driver");
+        return data->start_btn;
+    }
+    if (data->vm.slots[SLOT_NEXT_ROUND].want_visible) return data->next_round_btn;
+    if (!data->vm.slots[SLOT_CHOICES].want_visible || data->pending_choice)
+        return NULL; /* the computer's move, the results or a server reply pending */
+
+    int move = 1 + (int)(roll % (guint32)rules->n_moves);
+    for (GtkWidget *btn = gtk_widget_get_first_child(data->choices_box); btn; btn = gtk_widget_get_next_sibling(btn))
+        if (GPOINTER_TO_INT(g_object_get_data(G_OBJECT(btn), "rps-move")) == move) return btn;
+    return NULL;
+}
+
+static const char *drive_check(gpointer user_data) {
+    AppData *data = (AppData *)user_data;
+    const GameState *game = &data->game;
+
+    if (game->current_round > match_format.max_rounds + 1) return "round counter ran past the end of the match";
+    if (game->player_score + game->computer_score > game->current_round - 1) return "more wins than rounds played";
+    if (data->results_timeout_id && !game_is_over(game)) return "results pending for a match still in play";
+    return NULL;
+}
+
+static void drive_restart(GtkApplication *app) {
+    activate(app, NULL);
+}
+
 void activate(GtkApplication *app, gpointer user_data) {
     (void)user_data;
-    AppData *data = g_slice_new0(AppData);
-    srand((unsigned int)time(NULL)); /* seed RNG for computer choice */
+    AppData *data = g_new0(AppData, 1);
+    /* RPS_RULES=classic|rpsls|rps7 picks the variant before anything is built */
+    if (!rules_select_from_env()) g_printerr("RPS_RULES: unknown rules, playing %s\n", rules->name);
+    /* RPS_FORMAT=best-of-N|first-to-K[,no-draws][,max=R] (see engine.h) */
+    if (!match_format_select_from_env()) g_printerr("RPS_FORMAT: not a format, playing best-of-%d\n", TOTAL_ROUNDS);
+    /* RPS_RESULTS_DELAY_MS=<ms> from the deciding round to the result screen */
+    const char *delay = g_getenv("RPS_RESULTS_DELAY_MS");
+    if (delay && *delay) {
+        char *end;
+        guint64 ms = g_ascii_strtoull(delay, &end, 10);
+        if (*end || ms > 10000) g_printerr("RPS_RESULTS_DELAY_MS: not a delay, using %d\n", RESULTS_DELAY_MS);
+        else results_delay_ms = (guint)ms;
+    }
+    /* pick the computer player (RPS_OPPONENT, default uniform random;
+     * markov or frequency adapt to the player) and seed its RNG stream;
+     * set RPS_SEED to replay a session */
+    uint64_t seed = rng_seed_from_env("RPS_SEED");
+    const char *opponent_name = g_getenv("RPS_OPPONENT");
+    data->opponent = strategy_new(opponent_name ? opponent_name : "random", seed);
+    if (!data->opponent) data->opponent = strategy_new("random", seed);
+
+    /* RPS_SERVER=host:port (or unix:/path) plays against rps_server's bot instead */
+    const char *server_address = g_getenv("RPS_SERVER");
+    if (server_address && *server_address)
+        data->net = net_client_new(server_address, on_net_start, on_net_round, on_net_match, on_net_error, data);
+
+    /* RPS_MATCH_LOG=path appends every round to a binary log (see matchlog.h) */
+    const char *log_path = g_getenv("RPS_MATCH_LOG");
+    if (log_path && *log_path) {
+        data->match_log = matchlog_writer_open(log_path);
+        if (!data->match_log) g_printerr("match log: cannot open %s: %s\n", log_path, g_strerror(errno));
+    }
+    data->session_id = (uint32_t)rng_derive_seed(seed, 0x6c6f67); /* distinct per run, stable under RPS_SEED */
+    analytics_init(&data->stats);
 
     GtkWidget *window = gtk_application_window_new(app);
     gtk_widget_set_size_request(window, 800, 600);
     
     /* Store the window in AppData so the Exit button can use it */
     data->window = window;
+    leaderboard_view = data;
+    vm_init(&data->vm, window); /* widget updates are flushed on the window's frame clock */
+    g_object_set_data_full(G_OBJECT(window), "rps-app-data", data, free_app_data);
+    g_signal_connect(window, "destroy", G_CALLBACK(on_window_destroy), data);
+    if (g_getenv("RPS_VM_STATS"))
+        g_signal_connect(window, "destroy", G_CALLBACK(on_window_destroy_stats), data);
 
     GtkWidget *header = gtk_header_bar_new();
     gtk_window_set_titlebar(GTK_WINDOW(window), header);
@@ -521,7 +931,7 @@ void activate(GtkApplication *app, gpointer user_data) {
 
     GtkWidget *main_box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 0);
     gtk_widget_add_css_class(main_box, "window-bg");
-    gtk_window_set_child(GTK_WINDOW(window), main_box);
+    gtk_window_set_child(GTK_WINDOW(window), trace_wrap(main_box)); /* RPS_TRACE=overlay adds a latency readout */
 
     data->stack = gtk_stack_new();
     gtk_stack_set_transition_type(GTK_STACK(data->stack), GTK_STACK_TRANSITION_TYPE_SLIDE_LEFT_RIGHT);
@@ -531,23 +941,47 @@ void activate(GtkApplication *app, gpointer user_data) {
 
     gtk_box_append(GTK_BOX(main_box), data->stack);
 
-    /* add the three screens to the stack */
+    /* only the name screen is built up front; the other two are built on
+     * first navigation (see ensure_screen()) */
     gtk_stack_add_named(GTK_STACK(data->stack), create_name_screen(data), "name_screen");
-    gtk_stack_add_named(GTK_STACK(data->stack), create_game_screen(data), "game_screen");
-    gtk_stack_add_named(GTK_STACK(data->stack), create_result_screen(data), "result_screen");
 
     load_css(); /* apply app CSS */
 
     gtk_window_present(GTK_WINDOW(window));
-
-    gtk_widget_set_visible(data->next_round_btn, FALSE);
     gtk_stack_set_visible_child_name(GTK_STACK(data->stack), "name_screen");
+    trace_init(window); /* no-op unless RPS_TRACE is set */
+    render_profile_start(window, on_render_profile, data); /* rich, lite, or measure (RPS_RENDER_PROFILE) */
+
+    if (g_getenv("RPS_STARTUP_TIME") || g_getenv("RPS_EXIT_AFTER_FIRST_FRAME")) {
+        GdkFrameClock *clock = gtk_widget_get_frame_clock(window);
+        if (clock) g_signal_connect(clock, "after-paint", G_CALLBACK(on_first_frame_painted), window);
+    }
+    drive_attach(window, drive_step, drive_check, data, drive_restart); /* no-op unless RPS_DRIVE is set */
 }
 
 int main(int argc, char **argv) {
+    /* `rps --bots ...`: headless bot-vs-bot run, no GTK (see bots.h) */
+    if (argc > 1 && strcmp(argv[1], "--bots") == 0) return bots_main(argc - 1, argv + 1);
+
+    startup_begin_us = g_get_monotonic_time();
+    /* the driver's thousands of matches stay out of the real leaderboard unless asked for */
+    char *leaderboard_path = (drive_enabled() && !g_getenv("RPS_LEADERBOARD")) ? NULL : leaderboard_default_path();
+    if (leaderboard_path && !(leaderboard = leaderboard_open(leaderboard_path)))
+        g_printerr("leaderboard: cannot open %s: %s\n", leaderboard_path, g_strerror(errno));
+    free(leaderboard_path);
+
+    const char *events_path = g_getenv("RPS_EVENTS");
+    if ((match_events = eventbus_new(0)) && events_path && *events_path &&
+        !(event_log = event_log_start(match_events, events_path)))
+        g_printerr("events: cannot open %s: %s\n", events_path, g_strerror(errno));
+
     GtkApplication *app = gtk_application_new("com.example.rps", G_APPLICATION_DEFAULT_FLAGS);
     g_signal_connect(app, "activate", G_CALLBACK(activate), NULL);
     int status = g_application_run(G_APPLICATION(app), argc, argv);
     g_object_unref(app);
+    if (leaderboard_close(leaderboard) < 0) g_printerr("leaderboard: write failed, the last results may be missing\n");
+    if (event_log_stop(event_log) < 0) g_printerr("events: write failed, some events were not logged\n");
+    eventbus_free(match_events);
+    if (status == 0 && drive_enabled()) status = drive_status();
     return status;
 }
\ No newline at end of file
@@ -0,0 +1,377 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Append-only binary match log
+ * ----------------------------------------------------------------------------
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "matchlog.h"
+#include "rules.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define RPS_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+#define WRITER_BUFFERS 8          /* 8 x 64 KiB of slack before records are dropped */
+#define WRITER_IDLE_FLUSH_SEC 1   /* a partial block reaches the disk within this */
+
+uint64_t matchlog_now_ns(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* --- CRC-32C (the SSE4.2 crc32 instruction's polynomial) --- */
+static uint32_t crc_table[256];
+static uint32_t (*crc_impl)(uint32_t, const unsigned char *, size_t);
+static pthread_once_t crc_once = PTHREAD_ONCE_INIT;
+
+static uint32_t crc32c_table(uint32_t crc, const unsigned char *p, size_t len) {
+    while (len--) crc = crc_table[(crc ^ *p++) & 0xff] ^ (crc >> 8);
+    return crc;
+}
+
+#ifdef RPS_HAVE_X86
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_sse42(uint32_t crc, const unsigned char *p, size_t len) {
+#ifdef __x86_64__
+    uint64_t c = crc;
+    for (; len >= 8; len -= 8, p += 8) {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        c = _mm_crc32_u64(c, v);
+    }
+    crc = (uint32_t)c;
+#endif
+    while (len--) crc = _mm_crc32_u8(crc, *p++);
+    return crc;
+}
+#endif
+
+static void crc_init(void) {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++) c = (c >> 1) ^ (0x82f63b78u & (0u - (c & 1)));
+        crc_table[i] = c;
+    }
+    crc_impl = crc32c_table;
+#ifdef RPS_HAVE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.2")) crc_impl = crc32c_sse42;
+#endif
+}
+
+uint32_t matchlog_crc32c(uint32_t crc, const void *data, size_t len) {
+    pthread_once(&crc_once, crc_init);
+    return ~crc_impl(~crc, data, len);
+}
+
+/* --- Validation shared by reader and recovery --- */
+static int header_valid(const MatchLogHeader *h) {
+    return memcmp(h->magic, MATCHLOG_MAGIC, sizeof(MATCHLOG_MAGIC)) == 0 && h->version == MATCHLOG_VERSION
+           && h->record_size == sizeof(MatchLogRecord) && rules_by_id(h->rules) != NULL;
+}
+
+/* Size of the intact block at `offset`, 0 if there is none */
+static size_t block_at(const unsigned char *map, size_t size, size_t offset) {
+    MatchLogBlockHead head;
+    MatchLogBlockTail tail;
+    size_t body;
+
+    if (size - offset < sizeof(head) + sizeof(tail)) return 0;
+    memcpy(&head, map + offset, sizeof(head));
+    if (head.magic != MATCHLOG_BLOCK_MAGIC || head.count == 0 || head.count > MATCHLOG_BLOCK_RECORDS) return 0;
+    body = sizeof(head) + (size_t)head.count * sizeof(MatchLogRecord);
+    if (size - offset < body + sizeof(tail)) return 0;
+    memcpy(&tail, map + offset + body, sizeof(tail));
+    if (tail.count != head.count || tail.crc != matchlog_crc32c(0, map + offset, body)) return 0;
+    return body + sizeof(tail);
+}
+
+/* --- Reader --- */
+int matchlog_reader_open(MatchLogReader *r, const char *path) {
+    MatchLogHeader header;
+    struct stat st;
+    size_t offset, n;
+    void *map;
+    int fd;
+
+    memset(r, 0, sizeof(*r));
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(header)) {
+        close(fd);
+        errno = EINVAL;
+        return -1;
+    }
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return -1;
+    madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    memcpy(&header, map, sizeof(header));
+    if (!header_valid(&header)) {
+        munmap(map, (size_t)st.st_size);
+        errno = EINVAL;
+        return -1;
+    }
+    r->map = map;
+    r->size = (size_t)st.st_size;
+    r->created_ns = header.created_ns;
+    r->rules = header.rules;
+
+    for (offset = sizeof(header); (n = block_at(r->map, r->size, offset)) != 0; offset += n) {
+        r->blocks++;
+        r->records += (n - sizeof(MatchLogBlockHead) - sizeof(MatchLogBlockTail)) / sizeof(MatchLogRecord);
+    }
+    r->valid_end = offset;
+    r->truncated = offset != r->size;
+    return 0;
+}
+
+void matchlog_reader_close(MatchLogReader *r) {
+    if (r->map) munmap((void *)r->map, r->size);
+    memset(r, 0, sizeof(*r));
+}
+
+int matchlog_next_block(const MatchLogReader *r, size_t *offset, const MatchLogRecord **records, uint32_t *count) {
+    MatchLogBlockHead head;
+
+    if (*offset < sizeof(MatchLogHeader)) *offset = sizeof(MatchLogHeader);
+    if (*offset >= r->valid_end) return 0;
+    memcpy(&head, r->map + *offset, sizeof(head));
+    *records = (const MatchLogRecord *)(r->map + *offset + sizeof(head)); /* 8-byte aligned by layout */
+    *count = head.count;
+    *offset += sizeof(head) + (size_t)head.count * sizeof(MatchLogRecord) + sizeof(MatchLogBlockTail);
+    return 1;
+}
+
+long long matchlog_recover(const char *path) {
+    MatchLogReader r;
+    struct stat st;
+    long long removed;
+
+    if (stat(path, &st) < 0) return -1;
+    if ((size_t)st.st_size < sizeof(MatchLogHeader)) {
+        /* died while writing the header: start over */
+        if (truncate(path, 0) < 0) return -1;
+        return (long long)st.st_size;
+    }
+    if (matchlog_reader_open(&r, path) < 0) return -1;
+    removed = (long long)(r.size - r.valid_end);
+    matchlog_reader_close(&r);
+    if (removed > 0 && truncate(path, (off_t)(st.st_size - removed)) < 0) return -1;
+    return removed;
+}
+
+/* --- Writer --- */
+typedef struct {
+    MatchLogBlockHead head;
+    MatchLogRecord records[MATCHLOG_BLOCK_RECORDS];
+    MatchLogBlockTail tail_room; /* the tail goes right after the last record */
+} Block;
+
+struct MatchLogWriter {
+    int fd;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;        /* writer thread: a block is queued, or closing */
+    pthread_cond_t space;       /* matchlog_append_wait(): a block was written */
+    Block *blocks;              /* ring: `ready` queued from `next_write`, then the one being filled */
+    uint32_t next_write;
+    uint32_t ready;
+    int closing;
+    int error;
+    uint64_t dropped;
+    off_t good_end;             /* writer thread: end of the last complete block */
+    int stopped;                /* writer thread: a failed block could not be cut off */
+};
+
+static int write_all(int fd, const void *buf, size_t len) {
+    const char *p = buf;
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return -1;
+        p += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+static Block *filling_block(MatchLogWriter *w) {
+    return &w->blocks[(w->next_write + w->ready) % WRITER_BUFFERS];
+}
+
+/* Queue the block being filled, if it has anything in it (lock held) */
+static void queue_partial(MatchLogWriter *w) {
+    if (w->ready < WRITER_BUFFERS && filling_block(w)->head.count > 0) {
+        w->ready++;
+        pthread_cond_signal(&w->wake);
+    }
+}
+
+static void *writer_main(void *arg) {
+    MatchLogWriter *w = arg;
+
+    pthread_mutex_lock(&w->lock);
+    for (;;) {
+        while (w->ready == 0 && !w->closing) {
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_sec += WRITER_IDLE_FLUSH_SEC;
+            if (pthread_cond_timedwait(&w->wake, &w->lock, &deadline) == ETIMEDOUT) queue_partial(w);
+        }
+        if (w->ready == 0) break; /* closing and drained */
+
+        Block *b = &w->blocks[w->next_write];
+        pthread_mutex_unlock(&w->lock);
+
+        /* the producer never touches a queued block, so no lock for the I/O */
+        size_t body = sizeof(b->head) + (size_t)b->head.count * sizeof(MatchLogRecord);
+        MatchLogBlockTail tail = { matchlog_crc32c(0, b, body), b->head.count };
+        memcpy((char *)b + body, &tail, sizeof(tail));
+        int failed = w->stopped || write_all(w->fd, b, body + sizeof(tail)) < 0;
+        if (!failed) {
+            w->good_end += (off_t)(body + sizeof(tail));
+        } else if (!w->stopped && ftruncate(w->fd, w->good_end) < 0) {
+            /* a partial block left in place would hide every block after
+             * it from readers (and recovery would cut them off), so stop */
+            w->stopped = 1;
+        }
+
+        pthread_mutex_lock(&w->lock);
+        if (failed) {
+            w->error = 1;
+            w->dropped += b->head.count;
+        }
+        b->head.count = 0;
+        w->next_write = (w->next_write + 1) % WRITER_BUFFERS;
+        w->ready--;
+        pthread_cond_broadcast(&w->space);
+        if (w->closing) queue_partial(w);
+    }
+    pthread_mutex_unlock(&w->lock);
+    return NULL;
+}
+
+MatchLogWriter *matchlog_writer_open(const char *path) {
+    MatchLogWriter *w;
+    struct stat st;
+
+    if (access(path, F_OK) == 0 && matchlog_recover(path) < 0) return NULL;
+
+    w = calloc(1, sizeof(*w));
+    if (!w) return NULL;
+    w->blocks = calloc(WRITER_BUFFERS, sizeof(Block));
+    w->fd = open(path, O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644); /* read: the header check below */
+    if (!w->blocks || w->fd < 0 || fstat(w->fd, &st) < 0) goto fail;
+
+    if (st.st_size == 0) {
+        MatchLogHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, MATCHLOG_MAGIC, sizeof(MATCHLOG_MAGIC));
+        header.version = MATCHLOG_VERSION;
+        header.record_size = sizeof(MatchLogRecord);
+        header.rules = (uint16_t)rules->id;
+        header.created_ns = matchlog_now_ns();
+        if (write_all(w->fd, &header, sizeof(header)) < 0) goto fail;
+        w->good_end = (off_t)sizeof(header);
+    } else {
+        w->good_end = st.st_size; /* recovered above: whole blocks only */
+        MatchLogHeader header;
+        if (pread(w->fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)) goto fail;
+        if (header.rules != rules->id) {
+            errno = EINVAL; /* mixing numberings would make the log unreadable */
+            goto fail;
+        }
+    }
+    for (int i = 0; i < WRITER_BUFFERS; i++) w->blocks[i].head.magic = MATCHLOG_BLOCK_MAGIC;
+
+    pthread_mutex_init(&w->lock, NULL);
+    pthread_cond_init(&w->wake, NULL);
+    pthread_cond_init(&w->space, NULL);
+    if (pthread_create(&w->thread, NULL, writer_main, w) != 0) {
+        pthread_mutex_destroy(&w->lock);
+        pthread_cond_destroy(&w->wake);
+        pthread_cond_destroy(&w->space);
+        goto fail;
+    }
+    return w;
+
+fail:
+    if (w->fd >= 0) close(w->fd);
+    free(w->blocks);
+    free(w);
+    return NULL;
+}
+
+void matchlog_append(MatchLogWriter *w, const MatchLogRecord *record) {
+    pthread_mutex_lock(&w->lock);
+    if (w->ready == WRITER_BUFFERS) {
+        w->dropped++; /* disk is that far behind; do not stall the caller */
+    } else {
+        Block *b = filling_block(w);
+        b->records[b->head.count++] = *record;
+        if (b->head.count == MATCHLOG_BLOCK_RECORDS) queue_partial(w);
+    }
+    pthread_mutex_unlock(&w->lock);
+}
+
+void matchlog_append_wait(MatchLogWriter *w, const MatchLogRecord *record) {
+    Block *b;
+
+    pthread_mutex_lock(&w->lock);
+    while (w->ready == WRITER_BUFFERS) pthread_cond_wait(&w->space, &w->lock);
+    b = filling_block(w);
+    b->records[b->head.count++] = *record;
+    if (b->head.count == MATCHLOG_BLOCK_RECORDS) queue_partial(w);
+    pthread_mutex_unlock(&w->lock);
+}
+
+void matchlog_flush(MatchLogWriter *w) {
+    pthread_mutex_lock(&w->lock);
+    queue_partial(w);
+    pthread_mutex_unlock(&w->lock);
+}
+
+uint64_t matchlog_dropped(MatchLogWriter *w) {
+    uint64_t dropped;
+    pthread_mutex_lock(&w->lock);
+    dropped = w->dropped;
+    pthread_mutex_unlock(&w->lock);
+    return dropped;
+}
+
+int matchlog_writer_close(MatchLogWriter *w) {
+    int error;
+
+    if (!w) return 0;
+    pthread_mutex_lock(&w->lock);
+    w->closing = 1;
+    queue_partial(w);
+    pthread_cond_signal(&w->wake);
+    pthread_mutex_unlock(&w->lock);
+    pthread_join(w->thread, NULL);
+
+    error = w->error;
+    if (fdatasync(w->fd) < 0) error = 1;
+    if (close(w->fd) < 0) error = 1;
+    pthread_mutex_destroy(&w->lock);
+    pthread_cond_destroy(&w->wake);
+    pthread_cond_destroy(&w->space);
+    free(w->blocks);
+    free(w);
+    return error ? -1 : 0;
+}
@@ -0,0 +1,109 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Append-only binary match log (GTK-free)
+ * ----------------------------------------------------------------------------
+ * NOTE: File layout, all integers little-endian:
+ *
+ *   MatchLogHeader                       32 bytes, once
+ *   { MatchLogBlockHead                   8 bytes: magic, record count
+ *     MatchLogRecord[count]              16 bytes each
+ *     MatchLogBlockTail }                 8 bytes: CRC-32C of head + records, count again
+ *
+ * Blocks are only ever appended whole, so a crash or a full disk can at
+ * worst leave one partial block at the end. Readers stop at the first
+ * block whose tail is missing or whose CRC does not match; the writer
+ * truncates such a tail away before appending.
+ *
+ * The writer copies records into a block buffer under a mutex and a
+ * background thread does the write(); if the disk falls far enough behind
+ * that every buffer is full, records are counted as dropped rather than
+ * stalling the caller. The reader mmaps the file and hands out pointers
+ * straight into the mapping.
+ */
+
+#ifndef RPS_MATCHLOG_H
+#define RPS_MATCHLOG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MATCHLOG_MAGIC "RPSMLOG"
+#define MATCHLOG_VERSION 1
+#define MATCHLOG_BLOCK_MAGIC 0x4b4c4252u  /* "RBLK" */
+#define MATCHLOG_BLOCK_RECORDS 4096
+
+typedef struct {
+    char magic[8];              /* MATCHLOG_MAGIC, NUL-padded */
+    uint16_t version;
+    uint16_t record_size;       /* sizeof(MatchLogRecord) */
+    uint16_t rules;             /* RulesId the moves are numbered in; 0 = classic */
+    uint16_t flags;             /* reserved, 0 */
+    uint64_t created_ns;        /* wall clock, ns since the epoch */
+    uint64_t reserved;
+} MatchLogHeader;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t count;
+} MatchLogBlockHead;
+
+typedef struct {
+    uint32_t crc;
+    uint32_t count;
+} MatchLogBlockTail;
+
+typedef struct {
+    uint64_t timestamp_ns;      /* wall clock, ns since the epoch */
+    uint32_t session;           /* one match */
+    uint8_t round;              /* 1-based */
+    uint8_t player_move;        /* 1..n_moves of the log's rules */
+    uint8_t opponent_move;
+    uint8_t outcome;            /* RESULT_*, from the player's side */
+} MatchLogRecord;
+
+_Static_assert(sizeof(MatchLogHeader) == 32, "MatchLogHeader layout");
+_Static_assert(sizeof(MatchLogRecord) == 16, "MatchLogRecord layout");
+
+uint64_t matchlog_now_ns(void);
+uint32_t matchlog_crc32c(uint32_t crc, const void *data, size_t len);
+
+/* --- Writer --- */
+typedef struct MatchLogWriter MatchLogWriter;
+
+/* Opens (creating or recovering) `path` for appending records played under
+ * the active rules; NULL with errno set (EINVAL: the log uses other rules) */
+MatchLogWriter *matchlog_writer_open(const char *path);
+/* Never blocks on I/O */
+void matchlog_append(MatchLogWriter *w, const MatchLogRecord *record);
+/* For batch producers: waits for buffer space instead of dropping */
+void matchlog_append_wait(MatchLogWriter *w, const MatchLogRecord *record);
+/* Hand the partial block to the writer thread now rather than when full */
+void matchlog_flush(MatchLogWriter *w);
+uint64_t matchlog_dropped(MatchLogWriter *w);
+/* Writes everything still buffered, syncs and frees; returns -1 on I/O error */
+int matchlog_writer_close(MatchLogWriter *w);
+
+/* --- Reader --- */
+typedef struct {
+    const unsigned char *map;
+    size_t size;                /* file size */
+    size_t valid_end;           /* end of the last intact block */
+    uint64_t records;
+    uint64_t blocks;
+    uint64_t created_ns;
+    int rules;                  /* RulesId from the header */
+    int truncated;              /* bytes past valid_end were ignored */
+} MatchLogReader;
+
+/* Maps and validates `path`; returns -1 with errno set */
+int matchlog_reader_open(MatchLogReader *r, const char *path);
+void matchlog_reader_close(MatchLogReader *r);
+/* Next block's records, pointing into the mapping. Start with *offset = 0;
+ * returns 0 after the last intact block. */
+int matchlog_next_block(const MatchLogReader *r, size_t *offset, const MatchLogRecord **records, uint32_t *count);
+
+/* Cut a damaged tail off `path`; returns bytes removed, -1 on error */
+long long matchlog_recover(const char *path);
+
+#endif /* RPS_MATCHLOG_H */
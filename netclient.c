@@ -0,0 +1,236 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: GUI client for rps_server
+ * ----------------------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "netclient.h"
+#include "rules.h"
+#include "server.h"
+
+struct NetClient {
+    GSocketClient *client;
+    GSocketConnection *connection;
+    GDataInputStream *input;
+    GOutputStream *output;
+    GCancellable *cancellable;
+    GString *queued;            /* lines waiting for the connection / previous write */
+    char *writing;              /* buffer of the write in flight, NULL if idle */
+    gboolean failed;
+    gboolean freed;             /* net_client_free() called, waiting for `pending` to drain */
+    int pending;                /* async operations in flight */
+    NetStartFunc on_start;
+    NetRoundFunc on_round;
+    NetMatchFunc on_match;
+    NetErrorFunc on_error;
+    gpointer user_data;
+};
+
+static void net_write_next(NetClient *net);
+static void net_read_next(NetClient *net);
+
+/* Really release the client once it was freed and no callback can reach it */
+static gboolean net_release(NetClient *net) {
+    if (!net->freed || net->pending > 0) return FALSE;
+    g_clear_object(&net->input);
+    if (net->connection) g_io_stream_close(G_IO_STREAM(net->connection), NULL, NULL);
+    g_clear_object(&net->connection);
+    g_clear_object(&net->client);
+    g_clear_object(&net->cancellable);
+    g_string_free(net->queued, TRUE);
+    g_free(net->writing);
+    g_free(net);
+    return TRUE;
+}
+
+/* Every async callback starts here; TRUE means net is gone or going, stop */
+static gboolean net_callback_enter(NetClient *net) {
+    net->pending--;
+    if (net->freed) {
+        net_release(net);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static void net_fail(NetClient *net, const char *message) {
+    if (net->failed) return;
+    net->failed = TRUE;
+    g_cancellable_cancel(net->cancellable);
+    if (net->on_error) net->on_error(message, net->user_data);
+}
+
+/* --- Writing: one write_all_async at a time, the rest waits in `queued` --- */
+static void on_write_done(GObject *source, GAsyncResult *res, gpointer user_data) {
+    NetClient *net = user_data;
+    GError *error = NULL;
+    gboolean ok = g_output_stream_write_all_finish(G_OUTPUT_STREAM(source), res, NULL, &error);
+
+    if (net_callback_enter(net)) {
+        g_clear_error(&error);
+        return;
+    }
+    if (!ok) {
+        net_fail(net, error->message);
+        g_error_free(error);
+        return;
+    }
+    g_free(net->writing);
+    net->writing = NULL;
+    net_write_next(net);
+}
+
+static void net_write_next(NetClient *net) {
+    gsize len;
+
+    if (net->writing || !net->output || net->failed || net->queued->len == 0) return;
+    len = net->queued->len;
+    net->writing = g_string_free(net->queued, FALSE);
+    net->queued = g_string_new(NULL);
+    net->pending++;
+    g_output_stream_write_all_async(net->output, net->writing, len, G_PRIORITY_DEFAULT,
+                                    net->cancellable, on_write_done, net);
+}
+
+static void net_send_line(NetClient *net, const char *line) {
+    g_string_append(net->queued, line);
+    net_write_next(net);
+}
+
+/* --- Reading --- */
+static void handle_start(NetClient *net, const char *line) {
+    char spec[64], rules_name[16], message[128];
+    MatchFormat format;
+
+    if (sscanf(line, "START %*s %63s %15s", spec, rules_name) != 2 || !match_format_parse(spec, &format)) {
+        net_fail(net, "server sent a match format this client does not know");
+        return;
+    }
+    if (strcmp(rules_name, rules->name) != 0) {
+        g_snprintf(message, sizeof(message), "server plays %s rules, this game %s", rules_name, rules->name);
+        net_fail(net, message);
+        return;
+    }
+    if (net->on_start) net->on_start(&format, net->user_data);
+}
+
+static void handle_line(NetClient *net, const char *line) {
+    int round, you, them, result, your_score, their_score;
+
+
+    if (strncmp(line, "START ", 6) == 0) {
+        handle_start(net, line);
+    } else if (sscanf(line, "ROUND %d %d %d", &round, &you, &them) == 3) {
+        if (net->on_round) net->on_round(them, net->user_data);
+    } else if (sscanf(line, "MATCH %d %d %d", &result, &your_score, &their_score) == 3) {
+        if (net->on_match) net->on_match(your_score, their_score, net->user_data);
+    } else if (strncmp(line, "ERR", 3) == 0) {
+        net_fail(net, line);
+    }
+    /* WELCOME / WAIT need no action */
+}
+
+static void on_line_read(GObject *source, GAsyncResult *res, gpointer user_data) {
+    NetClient *net = user_data;
+    GError *error = NULL;
+    char *line = g_data_input_stream_read_line_finish(G_DATA_INPUT_STREAM(source), res, NULL, &error);
+
+    if (net_callback_enter(net)) {
+        g_free(line);
+        g_clear_error(&error);
+        return;
+    }
+    if (!line) {
+        net_fail(net, error ? error->message : "server closed the connection");
+        g_clear_error(&error);
+        return;
+    }
+    net->pending++; /* the callbacks below may free net; keep it alive until we are done */
+    handle_line(net, line);
+    g_free(line);
+    if (net_callback_enter(net)) return;
+    if (!net->failed) net_read_next(net);
+}
+
+static void net_read_next(NetClient *net) {
+    net->pending++;
+    g_data_input_stream_read_line_async(net->input, G_PRIORITY_DEFAULT, net->cancellable, on_line_read, net);
+}
+
+/* --- Connection --- */
+static void on_connected(GObject *source, GAsyncResult *res, gpointer user_data) {
+    NetClient *net = user_data;
+    GError *error = NULL;
+    GSocketConnection *connection = g_socket_client_connect_finish(G_SOCKET_CLIENT(source), res, &error);
+
+    if (net_callback_enter(net)) {
+        g_clear_object(&connection);
+        g_clear_error(&error);
+        return;
+    }
+    if (!connection) {
+        net_fail(net, error->message);
+        g_error_free(error);
+        return;
+    }
+    net->connection = connection;
+    net->output = g_io_stream_get_output_stream(G_IO_STREAM(connection));
+    net->input = g_data_input_stream_new(g_io_stream_get_input_stream(G_IO_STREAM(connection)));
+    g_data_input_stream_set_newline_type(net->input, G_DATA_STREAM_NEWLINE_TYPE_LF);
+    net_read_next(net);
+    net_write_next(net); /* anything queued while connecting */
+}
+
+NetClient *net_client_new(const char *address, NetStartFunc on_start, NetRoundFunc on_round, NetMatchFunc on_match,
+                          NetErrorFunc on_error, gpointer user_data) {
+    NetClient *net = g_new0(NetClient, 1);
+
+    net->on_start = on_start;
+    net->on_round = on_round;
+    net->on_match = on_match;
+    net->on_error = on_error;
+    net->user_data = user_data;
+    net->queued = g_string_new(NULL);
+    net->cancellable = g_cancellable_new();
+    net->client = g_socket_client_new();
+    net->pending++;
+    if (g_str_has_prefix(address, "unix:")) { /* same address forms as rps_server -a */
+        GSocketAddress *unix_address = g_unix_socket_address_new(address + 5);
+        g_socket_client_connect_async(net->client, G_SOCKET_CONNECTABLE(unix_address), net->cancellable,
+                                      on_connected, net);
+        g_object_unref(unix_address);
+    } else {
+        g_socket_client_connect_to_host_async(net->client, address, SERVER_DEFAULT_PORT,
+                                              net->cancellable, on_connected, net);
+    }
+    return net;
+}
+
+void net_client_start_match(NetClient *net, const char *player_name) {
+    char *line = g_strdup_printf("HELLO %s\nPLAY BOT\n", player_name);
+    net_send_line(net, line);
+    g_free(line);
+}
+
+void net_client_send_move(NetClient *net, int choice) {
+    char line[16];
+    g_snprintf(line, sizeof(line), "MOVE %d\n", choice);
+    net_send_line(net, line);
+}
+
+/* Cancels outstanding I/O. Buffers handed to GIO must outlive their
+ * operations, so the memory goes away with the last cancelled callback. */
+void net_client_free(NetClient *net) {
+    if (!net) return;
+    net->freed = TRUE;
+    net->on_start = NULL;
+    net->on_round = NULL;
+    net->on_match = NULL;
+    net->on_error = NULL;
+    g_cancellable_cancel(net->cancellable);
+    net_release(net);
+}
@@ -0,0 +1,38 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: GUI client for rps_server (GIO, main-loop driven)
+ * ----------------------------------------------------------------------------
+ * NOTE: Speaks the line protocol in server.h. All I/O is asynchronous on the
+ * GTK main loop; callbacks fire there too. Writes issued before the
+ * connection is up are queued and sent once it is.
+ *
+ * The server runs the match: START says in which format (the GUI plays
+ * that one) and MATCH has the last word on how it ended. A server on other
+ * rules is refused at START, since the two sides would not agree on moves.
+ */
+
+#ifndef RPS_NETCLIENT_H
+#define RPS_NETCLIENT_H
+
+#include <gio/gio.h>
+#include "engine.h"
+
+typedef struct NetClient NetClient;
+
+/* opponent's move for the round the player just sent */
+typedef void (*NetRoundFunc)(int opponent_choice, gpointer user_data);
+/* a match started in the server's format */
+typedef void (*NetStartFunc)(const MatchFormat *format, gpointer user_data);
+/* the server ended the match with these final scores */
+typedef void (*NetMatchFunc)(int player_score, int opponent_score, gpointer user_data);
+/* connection lost or server error; the client is unusable afterwards */
+typedef void (*NetErrorFunc)(const char *message, gpointer user_data);
+
+NetClient *net_client_new(const char *address, NetStartFunc on_start, NetRoundFunc on_round, NetMatchFunc on_match,
+                          NetErrorFunc on_error, gpointer user_data);
+void net_client_start_match(NetClient *net, const char *player_name);
+void net_client_send_move(NetClient *net, int choice);
+void net_client_free(NetClient *net);
+
+#endif /* RPS_NETCLIENT_H */
@@ -0,0 +1,58 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Buffered record output (GTK-free)
+ * ----------------------------------------------------------------------------
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "outbuf.h"
+
+const char outbuf_digit_pairs[200] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+int outbuf_init(OutBuf *out, int fd, size_t cap) {
+    out->fd = fd;
+    out->cap = cap ? cap : OUTBUF_DEFAULT_SIZE;
+    out->len = 0;
+    out->written = 0;
+    out->data = malloc(out->cap);
+    return out->data ? 0 : -1;
+}
+
+/* write() can stop short on a pipe; keep going until all of it is out */
+int outbuf_flush(OutBuf *out) {
+    size_t done = 0;
+
+    while (done < out->len) {
+        ssize_t n = write(out->fd, out->data + done, out->len - done);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            /* keep what was not written at the front, for a caller that retries */
+            memmove(out->data, out->data + done, out->len - done);
+            out->len -= done;
+            return -1;
+        }
+        done += (size_t)n;
+        out->written += (uint64_t)n;
+    }
+    out->len = 0;
+    return 0;
+}
+
+void outbuf_free(OutBuf *out) {
+    free(out->data);
+    out->data = NULL;
+    out->len = out->cap = 0;
+}
@@ -0,0 +1,79 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Buffered record output (GTK-free)
+ * ----------------------------------------------------------------------------
+ * NOTE: One large buffer, allocated once and reused: a producer reserves
+ * room for a whole record, formats straight into the buffer and commits
+ * the new end. Only a full buffer costs a write(). Numbers are formatted
+ * two digits at a time from a table, with no locale, no varargs and no
+ * allocation, so formatting a record costs about as much as copying it.
+ */
+
+#ifndef RPS_OUTBUF_H
+#define RPS_OUTBUF_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define OUTBUF_DEFAULT_SIZE (1u << 20)
+
+typedef struct {
+    int fd;
+    char *data;
+    size_t len;
+    size_t cap;
+    uint64_t written;           /* bytes handed to write() so far */
+} OutBuf;
+
+/* Returns -1 if the buffer cannot be allocated; cap 0 = OUTBUF_DEFAULT_SIZE */
+int outbuf_init(OutBuf *out, int fd, size_t cap);
+/* Write out everything buffered; -1 with errno set on a write error */
+int outbuf_flush(OutBuf *out);
+/* Releases the buffer; neither flushes nor closes the fd */
+void outbuf_free(OutBuf *out);
+
+/* Room for `n` more bytes (n <= cap), flushing first if needed; NULL on a
+ * write error */
+static inline char *outbuf_reserve(OutBuf *out, size_t n) {
+    if (out->cap - out->len < n && outbuf_flush(out) < 0) return NULL;
+    return out->data + out->len;
+}
+/* The reserved bytes up to `end` are now part of the output */
+static inline void outbuf_commit(OutBuf *out, char *end) {
+    out->len = (size_t)(end - out->data);
+}
+
+/* --- Formatting into reserved space; each returns the new end --- */
+extern const char outbuf_digit_pairs[200];
+
+static inline char *fmt_u64(char *p, uint64_t value) {
+    char tmp[20];
+    char *t = tmp + sizeof(tmp);
+    size_t n;
+
+    while (value >= 100) {
+        const char *pair = outbuf_digit_pairs + (value % 100) * 2;
+        value /= 100;
+        *--t = pair[1];
+        *--t = pair[0];
+    }
+    if (value >= 10) {
+        const char *pair = outbuf_digit_pairs + value * 2;
+        *--t = pair[1];
+        *--t = pair[0];
+    } else {
+        *--t = (char)('0' + value);
+    }
+    n = (size_t)(tmp + sizeof(tmp) - t);
+    memcpy(p, t, n);
+    return p + n;
+}
+
+static inline char *fmt_bytes(char *p, const void *bytes, size_t n) {
+    memcpy(p, bytes, n);
+    return p + n;
+}
+
+#endif /* RPS_OUTBUF_H */
@@ -0,0 +1,147 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Branchless round outcome + batch kernel
+ * ----------------------------------------------------------------------------
+ */
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "outcome.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define RPS_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+typedef void (*ResolveFn)(const uint8_t *packed, size_t n, uint8_t *outcomes, int8_t *scores);
+
+/* --- Scalar --- */
+static void resolve_scalar(const uint8_t *packed, size_t n, uint8_t *outcomes, int8_t *scores) {
+    for (size_t i = 0; i < n; i++) {
+        int o = outcome_of((packed[i] >> 2) & 3, packed[i] & 3);
+        if (outcomes) outcomes[i] = (uint8_t)o;
+        if (scores) scores[i] = (int8_t)outcome_score(o);
+    }
+}
+
+#ifdef RPS_HAVE_X86
+/* --- SSE2 (16 rounds per step) --- */
+__attribute__((target("sse2")))
+static void resolve_sse2(const uint8_t *packed, size_t n, uint8_t *outcomes, int8_t *scores) {
+    const __m128i three = _mm_set1_epi8(3);
+    const __m128i two = _mm_set1_epi8(2);
+    const __m128i one = _mm_set1_epi8(1);
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(packed + i));
+        /* 16-bit shift leaks bits across bytes; the mask drops them */
+        __m128i p = _mm_and_si128(_mm_srli_epi16(x, 2), three);
+        __m128i c = _mm_and_si128(x, three);
+        __m128i d = _mm_add_epi8(_mm_sub_epi8(p, c), three);
+        __m128i o = _mm_sub_epi8(d, _mm_and_si128(_mm_cmpgt_epi8(d, two), three));
+
+        if (outcomes) _mm_storeu_si128((__m128i *)(outcomes + i), o);
+        if (scores) {
+            __m128i s = _mm_sub_epi8(_mm_cmpeq_epi8(o, two), _mm_cmpeq_epi8(o, one));
+            _mm_storeu_si128((__m128i *)(scores + i), s);
+        }
+    }
+    resolve_scalar(packed + i, n - i, outcomes ? outcomes + i : NULL, scores ? scores + i : NULL);
+}
+
+/* --- AVX2 (32 rounds per step) --- */
+__attribute__((target("avx2")))
+static void resolve_avx2(const uint8_t *packed, size_t n, uint8_t *outcomes, int8_t *scores) {
+    const __m256i three = _mm256_set1_epi8(3);
+    const __m256i two = _mm256_set1_epi8(2);
+    const __m256i one = _mm256_set1_epi8(1);
+    size_t i = 0;
+
+    for (; i + 32 <= n; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(packed + i));
+        __m256i p = _mm256_and_si256(_mm256_srli_epi16(x, 2), three);
+        __m256i c = _mm256_and_si256(x, three);
+        __m256i d = _mm256_add_epi8(_mm256_sub_epi8(p, c), three);
+        __m256i o = _mm256_sub_epi8(d, _mm256_and_si256(_mm256_cmpgt_epi8(d, two), three));
+
+        if (outcomes) _mm256_storeu_si256((__m256i *)(outcomes + i), o);
+        if (scores) {
+            __m256i s = _mm256_sub_epi8(_mm256_cmpeq_epi8(o, two), _mm256_cmpeq_epi8(o, one));
+            _mm256_storeu_si256((__m256i *)(scores + i), s);
+        }
+    }
+    resolve_sse2(packed + i, n - i, outcomes ? outcomes + i : NULL, scores ? scores + i : NULL);
+}
+#endif /* RPS_HAVE_X86 */
+
+/* --- Dispatch --- */
+typedef struct {
+    ResolveFn fn;
+    const char *name;
+} Kernel;
+
+static const Kernel kernels[] = {
+    { resolve_scalar, "scalar" },
+#ifdef RPS_HAVE_X86
+    { resolve_sse2, "sse2" },
+    { resolve_avx2, "avx2" },
+#endif
+};
+
+/* One pointer, so a thread never sees one kernel's function with another's name */
+static _Atomic(const Kernel *) active_kernel = NULL;
+
+static int kernel_supported(const char *name) {
+    if (strcmp(name, "scalar") == 0) return 1;
+#ifdef RPS_HAVE_X86
+    __builtin_cpu_init();
+    if (strcmp(name, "sse2") == 0) return __builtin_cpu_supports("sse2");
+    if (strcmp(name, "avx2") == 0) return __builtin_cpu_supports("avx2");
+#endif
+    return 0;
+}
+
+static const Kernel *kernel_find(const char *name) {
+    if (!name || !kernel_supported(name)) return NULL;
+    for (size_t i = 0; i < sizeof(kernels) / sizeof(kernels[0]); i++)
+        if (strcmp(kernels[i].name, name) == 0) return &kernels[i];
+    return NULL;
+}
+
+int outcome_kernel_select(const char *name) {
+    const Kernel *k = kernel_find(name);
+
+    if (!k) return 0;
+    atomic_store_explicit(&active_kernel, k, memory_order_release);
+    return 1;
+}
+
+/* Widest available ISA, unless RPS_SIMD names a narrower one */
+static const Kernel *kernel_pick(void) {
+    const Kernel *k = kernel_find(getenv("RPS_SIMD"));
+    if (!k) k = kernel_find("avx2");
+    if (!k) k = kernel_find("sse2");
+    return k ? k : &kernels[0];
+}
+
+/* First use picks; an outcome_kernel_select() that got there first wins */
+static const Kernel *kernel_active(void) {
+    const Kernel *k = atomic_load_explicit(&active_kernel, memory_order_acquire), *none = NULL;
+
+    if (k) return k;
+    k = kernel_pick();
+    if (!atomic_compare_exchange_strong_explicit(&active_kernel, &none, k, memory_order_acq_rel, memory_order_acquire))
+        k = none;
+    return k;
+}
+
+const char *outcome_kernel_name(void) {
+    return kernel_active()->name;
+}
+
+void resolve_rounds(const uint8_t *packed, size_t n, uint8_t *outcomes, int8_t *scores) {
+    kernel_active()->fn(packed, n, outcomes, scores);
+}
@@ -0,0 +1,47 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Branchless round outcome + batch kernel (GTK-free)
+ * ----------------------------------------------------------------------------
+ * NOTE: With moves numbered 1..3, (player - computer) mod 3 is already the
+ * RESULT_* code: 0 draw, 1 player win, 2 computer win. The batch kernel
+ * works on packed bytes, (player << 2) | computer, and every SIMD path
+ * runs the exact same arithmetic as outcome_of(), so results are
+ * bit-identical for all 256 byte values, not just valid moves.
+ *
+ * This is the classic three-move game only; other variants decide rounds
+ * through their outcome table in rules.h, which agrees with outcome_of()
+ * for the classic rules.
+ */
+
+#ifndef RPS_OUTCOME_H
+#define RPS_OUTCOME_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Pack one round into a byte for the batch kernel */
+static inline uint8_t pack_moves(int player_choice, int computer_choice) {
+    return (uint8_t)(((player_choice & 3) << 2) | (computer_choice & 3));
+}
+
+/* 0 draw, 1 player win, 2 computer win; no branches, no table */
+static inline int outcome_of(int player_choice, int computer_choice) {
+    int d = player_choice - computer_choice + 3;
+    return d - 3 * (d > 2);
+}
+
+/* Player's score delta for an outcome: +1 win, 0 draw, -1 loss */
+static inline int outcome_score(int outcome) {
+    return (outcome == 1) - (outcome == 2);
+}
+
+/* Resolve n packed rounds into outcome codes and player score deltas.
+ * Either output array may be NULL. Picks the widest ISA at first call. */
+void resolve_rounds(const uint8_t *packed, size_t n, uint8_t *outcomes, int8_t *scores);
+
+/* Force a specific kernel ("scalar", "sse2", "avx2"); returns 0 if unavailable */
+int outcome_kernel_select(const char *name);
+const char *outcome_kernel_name(void);
+
+#endif /* RPS_OUTCOME_H */
@@ -0,0 +1,113 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Fixed-size record pool with stable handles
+ * ----------------------------------------------------------------------------
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "pool.h"
+
+#define FREE_END UINT32_MAX
+#define GEN_RETIRED UINT8_MAX     /* never in a handle: the slot is out of generations */
+
+static inline unsigned char *record_at(const Pool *pool, uint32_t index) {
+    return pool->slabs[index >> POOL_SLAB_SHIFT] + (size_t)(index & (POOL_SLAB_RECORDS - 1)) * pool->record_size;
+}
+
+static inline uint8_t *generation_at(const Pool *pool, uint32_t index) {
+    return pool->slabs[index >> POOL_SLAB_SHIFT] + (size_t)POOL_SLAB_RECORDS * pool->record_size
+           + (index & (POOL_SLAB_RECORDS - 1));
+}
+
+void pool_init(Pool *pool, size_t record_size) {
+    memset(pool, 0, sizeof(*pool));
+    if (record_size < sizeof(uint32_t)) record_size = sizeof(uint32_t); /* free-list link */
+    pool->record_size = (record_size + 7) & ~(size_t)7;
+    pool->free_head = FREE_END;
+}
+
+void pool_destroy(Pool *pool) {
+    for (uint32_t i = 0; i < pool->n_slabs; i++) free(pool->slabs[i]);
+    free(pool->slabs);
+    memset(pool, 0, sizeof(*pool));
+    pool->free_head = FREE_END;
+}
+
+/* Add one zeroed slab; its records are handed out by bumping `used` */
+static int pool_grow(Pool *pool) {
+    unsigned char *slab;
+
+    if ((uint64_t)(pool->n_slabs + 1) * POOL_SLAB_RECORDS > POOL_MAX_RECORDS) return -1;
+    if (pool->n_slabs == pool->slab_capacity) {
+        uint32_t cap = pool->slab_capacity ? pool->slab_capacity * 2 : 16;
+        unsigned char **slabs = realloc(pool->slabs, cap * sizeof(*slabs));
+        if (!slabs) return -1;
+        pool->slabs = slabs;
+        pool->slab_capacity = cap;
+    }
+    /* calloc: untouched records of a big slab stay unbacked pages */
+    slab = calloc(1, (size_t)POOL_SLAB_RECORDS * (pool->record_size + 1));
+    if (!slab) return -1;
+    pool->slabs[pool->n_slabs++] = slab;
+    return 0;
+}
+
+int pool_reserve(Pool *pool, uint32_t records) {
+    while ((uint64_t)pool->n_slabs * POOL_SLAB_RECORDS < records)
+        if (pool_grow(pool) < 0) return -1;
+    return 0;
+}
+
+void *pool_alloc(Pool *pool, PoolHandle *handle) {
+    unsigned char *record;
+    uint8_t *gen;
+    uint32_t index;
+
+    if (pool->free_head != FREE_END) {
+        index = pool->free_head;
+        record = record_at(pool, index);
+        memcpy(&pool->free_head, record, sizeof(uint32_t));
+        memset(record, 0, pool->record_size);
+    } else {
+        if (pool->used == pool->n_slabs * POOL_SLAB_RECORDS && pool_grow(pool) < 0) return NULL;
+        index = pool->used++;
+        record = record_at(pool, index); /* fresh from calloc */
+    }
+    gen = generation_at(pool, index);
+    if (*gen == 0) *gen = 1; /* generation 0 is never live: keeps handle 0 invalid */
+    pool->live++;
+    *handle = ((PoolHandle)*gen << POOL_INDEX_BITS) | index;
+    return record;
+}
+
+void pool_free(Pool *pool, PoolHandle handle) {
+    uint32_t index = handle & (POOL_MAX_RECORDS - 1);
+    uint8_t *gen;
+
+    if (!pool_get(pool, handle)) return; /* stale or double free */
+    gen = generation_at(pool, index);
+    pool->live--;
+    if (++*gen == GEN_RETIRED) {
+        /* wrapping round would let the oldest handles resolve again:
+         * the slot is never handed out any more (1 in 254 frees) */
+        pool->retired++;
+        return;
+    }
+    memcpy(record_at(pool, index), &pool->free_head, sizeof(uint32_t));
+    pool->free_head = index;
+}
+
+void *pool_get(const Pool *pool, PoolHandle handle) {
+    uint32_t index = handle & (POOL_MAX_RECORDS - 1);
+
+    if (index >= pool->used) return NULL;
+    if (*generation_at(pool, index) != (uint8_t)(handle >> POOL_INDEX_BITS)) return NULL;
+    return record_at(pool, index);
+}
+
+size_t pool_bytes(const Pool *pool) {
+    return (size_t)pool->n_slabs * POOL_SLAB_RECORDS * (pool->record_size + 1)
+           + pool->slab_capacity * sizeof(unsigned char *);
+}
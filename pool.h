@@ -0,0 +1,55 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Fixed-size record pool with stable handles (GTK-free)
+ * ----------------------------------------------------------------------------
+ * NOTE: Records live in slabs of POOL_SLAB_RECORDS that are never moved or
+ * freed until pool_destroy(), so pointers stay valid for a record's whole
+ * life. A handle is the record index plus an 8-bit generation bumped on
+ * every free, so a stale handle resolves to NULL instead of to whoever
+ * reused the slot. A slot that has used up its 254 generations is retired
+ * instead of wrapping round, so that holds however often one slot is
+ * reused, at the cost of one record per 254 frees of it. Freed records go
+ * on an intrusive free list, fresh ones are bumped out of the last slab;
+ * memory is only requested when a slab fills up (or up front via
+ * pool_reserve()).
+ */
+
+#ifndef RPS_POOL_H
+#define RPS_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define POOL_SLAB_SHIFT 12
+#define POOL_SLAB_RECORDS (1u << POOL_SLAB_SHIFT)
+#define POOL_INDEX_BITS 24
+#define POOL_MAX_RECORDS (1u << POOL_INDEX_BITS)
+
+typedef uint32_t PoolHandle;    /* 0 is never a valid handle */
+#define POOL_NULL_HANDLE 0u
+
+typedef struct {
+    size_t record_size;         /* rounded up to 8 bytes */
+    unsigned char **slabs;      /* each: records, then one generation byte per record */
+    uint32_t n_slabs;
+    uint32_t slab_capacity;
+    uint32_t used;              /* records handed out at least once */
+    uint32_t free_head;         /* index of first freed record, UINT32_MAX if none */
+    uint32_t live;
+    uint32_t retired;           /* slots out of generations, never reused */
+} Pool;
+
+void pool_init(Pool *pool, size_t record_size);
+void pool_destroy(Pool *pool);
+int pool_reserve(Pool *pool, uint32_t records);
+
+/* Zeroed record, or NULL when out of memory / handles */
+void *pool_alloc(Pool *pool, PoolHandle *handle);
+void pool_free(Pool *pool, PoolHandle handle);
+void *pool_get(const Pool *pool, PoolHandle handle);
+
+/* Bytes held by the pool, slabs and bookkeeping included */
+size_t pool_bytes(const Pool *pool);
+
+#endif /* RPS_POOL_H */
@@ -0,0 +1,185 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Rendering profile (rich / lite)
+ * ----------------------------------------------------------------------------
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "render.h"
+#include "rules.h"
+
+#define PROBE_SKIP_FRAMES 2          /* the first frames also do initial layout and font loading */
+#define ICON_PIXELS 36               /* matches .choice-emoji in style.css */
+#define ICON_CACHE_SIZE RULES_MAX_MOVES /* one per move of the largest rule set */
+
+static RenderProfile current_profile = RENDER_RICH;
+
+RenderProfile render_profile(void) {
+    return current_profile;
+}
+
+/* --- Startup probe --- */
+typedef struct {
+    GtkWidget *window;
+    GdkFrameClock *clock;
+    RenderProfileFunc apply;
+    gpointer user_data;
+    guint tick_id;
+    int frames;                  /* painted so far, skipped ones included */
+    gint64 frame_begin_us;
+    gint64 samples[RENDER_PROBE_FRAMES];
+    int n_samples;
+} Probe;
+
+static int compare_gint64(const void *a, const void *b) {
+    gint64 x = *(const gint64 *)a, y = *(const gint64 *)b;
+    return (x > y) - (x < y);
+}
+
+static void on_probe_before_paint(GdkFrameClock *clock, gpointer user_data) {
+    Probe *probe = user_data;
+    (void)clock;
+    probe->frame_begin_us = g_get_monotonic_time();
+}
+
+static void on_probe_after_paint(GdkFrameClock *clock, gpointer user_data);
+static void on_probe_window_destroy(GtkWidget *window, gpointer user_data);
+
+static void probe_release(Probe *probe) {
+    g_signal_handlers_disconnect_by_func(probe->clock, G_CALLBACK(on_probe_before_paint), probe);
+    g_signal_handlers_disconnect_by_func(probe->clock, G_CALLBACK(on_probe_after_paint), probe);
+    g_signal_handlers_disconnect_by_func(probe->window, G_CALLBACK(on_probe_window_destroy), probe);
+    gtk_widget_remove_tick_callback(probe->window, probe->tick_id);
+    g_object_unref(probe->clock);
+    g_free(probe);
+}
+
+/* Window closed before the probe had its samples: no profile is applied */
+static void on_probe_window_destroy(GtkWidget *window, gpointer user_data) {
+    (void)window;
+    probe_release(user_data);
+}
+
+static void probe_finish(Probe *probe) {
+    gint64 median;
+    GskRenderer *renderer = gtk_native_get_renderer(GTK_NATIVE(probe->window));
+
+    qsort(probe->samples, (size_t)probe->n_samples, sizeof(gint64), compare_gint64);
+    median = probe->samples[probe->n_samples / 2];
+    current_profile = (median > RENDER_LITE_FRAME_US) ? RENDER_LITE : RENDER_RICH;
+    if (g_strcmp0(g_getenv("RPS_RENDER_PROFILE"), "auto") == 0)
+        g_printerr("render: %s, median frame %.2f ms over %d frames -> %s\n",
+                   renderer ? G_OBJECT_TYPE_NAME(renderer) : "no renderer", median / 1000.0, probe->n_samples,
+                   current_profile == RENDER_LITE ? "lite" : "rich");
+
+    probe->apply(current_profile, probe->user_data);
+    probe_release(probe);
+}
+
+static void on_probe_after_paint(GdkFrameClock *clock, gpointer user_data) {
+    Probe *probe = user_data;
+
+    if (probe->frame_begin_us && probe->frames++ >= PROBE_SKIP_FRAMES)
+        probe->samples[probe->n_samples++] = g_get_monotonic_time() - probe->frame_begin_us;
+    probe->frame_begin_us = 0;
+    if (probe->n_samples == RENDER_PROBE_FRAMES) probe_finish(probe);
+}
+
+/* Keep the window repainting until the probe has its samples */
+static gboolean on_probe_tick(GtkWidget *widget, GdkFrameClock *clock, gpointer user_data) {
+    (void)clock; (void)user_data;
+    gtk_widget_queue_draw(widget);
+    return G_SOURCE_CONTINUE;
+}
+
+void render_profile_start(GtkWidget *window, RenderProfileFunc apply, gpointer user_data) {
+    const char *forced = g_getenv("RPS_RENDER_PROFILE");
+    GdkFrameClock *clock;
+    Probe *probe;
+
+    if (forced && (strcmp(forced, "rich") == 0 || strcmp(forced, "lite") == 0)) {
+        current_profile = (forced[0] == 'l') ? RENDER_LITE : RENDER_RICH;
+        apply(current_profile, user_data);
+        return;
+    }
+    clock = gtk_widget_get_frame_clock(window);
+    if (!clock) {
+        apply(current_profile, user_data);
+        return;
+    }
+
+    probe = g_new0(Probe, 1);
+    probe->window = window;
+    probe->clock = g_object_ref(clock);
+    probe->apply = apply;
+    probe->user_data = user_data;
+    g_signal_connect(clock, "before-paint", G_CALLBACK(on_probe_before_paint), probe);
+    g_signal_connect(clock, "after-paint", G_CALLBACK(on_probe_after_paint), probe);
+    probe->tick_id = gtk_widget_add_tick_callback(window, on_probe_tick, probe, NULL);
+    g_signal_connect(window, "destroy", G_CALLBACK(on_probe_window_destroy), probe);
+}
+
+/* --- Pre-rasterised choice icons --- */
+typedef struct {
+    char *emoji;
+    GdkTexture *texture;
+} IconCacheEntry;
+
+static IconCacheEntry icon_cache[ICON_CACHE_SIZE];
+
+static GdkTexture *rasterize_emoji(GtkWidget *window, const char *emoji) {
+    GskRenderer *renderer = gtk_native_get_renderer(GTK_NATIVE(window));
+    PangoLayout *layout;
+    PangoFontDescription *font;
+    GtkSnapshot *snapshot;
+    GskRenderNode *node;
+    GdkTexture *texture;
+    GdkRGBA ink = { 0.2f, 0.2f, 0.2f, 1.0f }; /* only used by monochrome emoji fonts */
+    int width, height;
+
+    if (!renderer) return NULL;
+    layout = gtk_widget_create_pango_layout(window, emoji);
+    font = pango_font_description_new();
+    pango_font_description_set_absolute_size(font, ICON_PIXELS * PANGO_SCALE);
+    pango_layout_set_font_description(layout, font);
+    pango_font_description_free(font);
+    pango_layout_get_pixel_size(layout, &width, &height);
+
+    snapshot = gtk_snapshot_new();
+    gtk_snapshot_append_layout(snapshot, layout, &ink);
+    node = gtk_snapshot_free_to_node(snapshot);
+    texture = node ? gsk_renderer_render_texture(renderer, node, &GRAPHENE_RECT_INIT(0, 0, width, height)) : NULL;
+    if (node) gsk_render_node_unref(node);
+    g_object_unref(layout);
+    return texture;
+}
+
+static GdkTexture *cached_icon(GtkWidget *window, const char *emoji) {
+    for (int i = 0; i < ICON_CACHE_SIZE; i++) {
+        if (!icon_cache[i].emoji) {
+            icon_cache[i].texture = rasterize_emoji(window, emoji);
+            if (!icon_cache[i].texture) return NULL;
+            icon_cache[i].emoji = g_strdup(emoji);
+            return icon_cache[i].texture;
+        }
+        if (strcmp(icon_cache[i].emoji, emoji) == 0) return icon_cache[i].texture;
+    }
+    return NULL;
+}
+
+GtkWidget *render_choice_icon(GtkWidget *window, const char *emoji) {
+    GdkTexture *texture = (current_profile == RENDER_LITE) ? cached_icon(window, emoji) : NULL;
+    GtkWidget *icon;
+
+    if (!texture) {
+        icon = gtk_label_new(emoji);
+        gtk_widget_add_css_class(icon, "choice-emoji");
+        return icon;
+    }
+    icon = gtk_picture_new_for_paintable(GDK_PAINTABLE(texture));
+    gtk_picture_set_can_shrink(GTK_PICTURE(icon), FALSE);
+    gtk_widget_add_css_class(icon, "choice-emoji");
+    return icon;
+}
@@ -0,0 +1,42 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Rendering profile (rich / lite)
+ * ----------------------------------------------------------------------------
+ * NOTE: The rich profile is the normal look. The lite profile is for
+ * software-rendered and remote sessions: no shadows or rounded clips, no
+ * stack transition, and the choice glyphs are emoji rasterised once into
+ * textures rather than shaped as text at every snapshot.
+ *
+ * RPS_RENDER_PROFILE=rich|lite forces a profile. Unset (or "auto"), a few
+ * forced redraws are timed after startup and lite is picked when the
+ * median frame takes longer than RENDER_LITE_FRAME_US. "auto" also
+ * prints the measurement to stderr.
+ */
+
+#ifndef RPS_RENDER_H
+#define RPS_RENDER_H
+
+#include <gtk/gtk.h>
+
+#define RENDER_PROBE_FRAMES 24
+#define RENDER_LITE_FRAME_US 6000    /* over a third of a 60 Hz frame just to paint a static screen */
+
+typedef enum {
+    RENDER_RICH,
+    RENDER_LITE
+} RenderProfile;
+
+typedef void (*RenderProfileFunc)(RenderProfile profile, gpointer user_data);
+
+/* Decide the profile for `window` (already presented) and call `apply`
+ * once with it: immediately when forced, after the probe otherwise.
+ * Until then render_profile() reports RENDER_RICH. */
+void render_profile_start(GtkWidget *window, RenderProfileFunc apply, gpointer user_data);
+RenderProfile render_profile(void);
+
+/* Choice glyph for the current profile: an emoji label (rich), or a
+ * picture of the emoji rasterised once per glyph with `window`'s renderer */
+GtkWidget *render_choice_icon(GtkWidget *window, const char *emoji);
+
+#endif /* RPS_RENDER_H */
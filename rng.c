@@ -0,0 +1,85 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Seedable PRNG streams
+ * ----------------------------------------------------------------------------
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "rng.h"
+
+/* splitmix64 expands a single 64-bit seed into the 256-bit xoshiro state */
+static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+void rng_seed(Rng *rng, uint64_t seed) {
+    uint64_t x = seed;
+    for (int i = 0; i < 4; i++) rng->s[i] = splitmix64(&x);
+}
+
+/* Advance the stream by 2^128 draws (reference xoshiro256 jump polynomial) */
+void rng_jump(Rng *rng) {
+    static const uint64_t JUMP[] = {
+        0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+        0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+    };
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (JUMP[i] & (1ULL << b)) {
+                s0 ^= rng->s[0];
+                s1 ^= rng->s[1];
+                s2 ^= rng->s[2];
+                s3 ^= rng->s[3];
+            }
+            rng_next(rng);
+        }
+    }
+    rng->s[0] = s0;
+    rng->s[1] = s1;
+    rng->s[2] = s2;
+    rng->s[3] = s3;
+}
+
+/* Stream k of a seed: the seeded state jumped k times. Streams never overlap,
+ * so worker k of a replay always sees the same draws. */
+void rng_stream(Rng *rng, uint64_t seed, unsigned stream_index) {
+    rng_seed(rng, seed);
+    for (unsigned i = 0; i < stream_index; i++) rng_jump(rng);
+}
+
+/* Cheap independent sub-seed for work item `index` (thousands of tasks, where
+ * rng_stream()'s jumps would cost more than the work itself) */
+uint64_t rng_derive_seed(uint64_t seed, uint64_t index) {
+    uint64_t x = seed ^ (index * 0xd1b54a32d192ed03ULL);
+    return splitmix64(&x);
+}
+
+/* Seed from an environment variable (for reproducible replays), else from the
+ * clock; a value that is not a whole number is reported, not read as 0 */
+uint64_t rng_seed_from_env(const char *env_name) {
+    const char *value = env_name ? getenv(env_name) : NULL;
+    struct timespec ts;
+
+    if (value && *value) {
+        char *end;
+        uint64_t seed;
+
+        errno = 0;
+        seed = strtoull(value, &end, 0);
+        /* strtoull skips blanks and negates "-1" into a huge seed: no minus anywhere */
+        if (errno == 0 && *end == '\0' && !strchr(value, '-')) return seed;
+        fprintf(stderr, "%s: not a seed (%s), seeding from the clock\n", env_name, value);
+    }
+    timespec_get(&ts, TIME_UTC);
+    return ((uint64_t)ts.tv_sec << 32) ^ (uint64_t)ts.tv_nsec;
+}
@@ -0,0 +1,62 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Seedable PRNG streams (GTK-free)
+ * ----------------------------------------------------------------------------
+ * NOTE: xoshiro256** generator. Each Rng is an independent stream with no
+ * hidden global state, so give every thread/session its own. rng_jump()
+ * advances a stream by 2^128 draws, which is how non-overlapping streams
+ * are carved out of one seed (see rng_stream()).
+ */
+
+#ifndef RPS_RNG_H
+#define RPS_RNG_H
+
+#include <stdint.h>
+
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+void rng_seed(Rng *rng, uint64_t seed);
+void rng_jump(Rng *rng);
+void rng_stream(Rng *rng, uint64_t seed, unsigned stream_index);
+uint64_t rng_derive_seed(uint64_t seed, uint64_t index);
+uint64_t rng_seed_from_env(const char *env_name);
+
+static inline uint64_t rng_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+/* Next raw 64-bit draw */
+static inline uint64_t rng_next(Rng *rng) {
+    uint64_t *s = rng->s;
+    uint64_t result = rng_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 45);
+    return result;
+}
+
+/* Unbiased draw in [0, bound). Lemire's multiply-shift: one multiply on the
+ * common path, a rejection loop only for the few values that would bias. */
+static inline uint32_t rng_bounded(Rng *rng, uint32_t bound) {
+    uint64_t m = (uint64_t)(uint32_t)(rng_next(rng) >> 32) * bound;
+    uint32_t low = (uint32_t)m;
+
+    if (low < bound) {
+        uint32_t threshold = (uint32_t)(-bound) % bound;
+        while (low < threshold) {
+            m = (uint64_t)(uint32_t)(rng_next(rng) >> 32) * bound;
+            low = (uint32_t)m;
+        }
+    }
+    return (uint32_t)(m >> 32);
+}
+
+#endif /* RPS_RNG_H */
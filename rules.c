@@ -0,0 +1,86 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Cyclic rule sets
+ * ----------------------------------------------------------------------------
+ */
+
+#include <stdlib.h>
+#include <strings.h>
+#include "rules.h"
+
+/* --- Table generation --- */
+#define RULES_COUNT(id, label, emoji) + 1
+#define RULES_NAME(id, label, emoji) #id,
+#define RULES_LABEL(id, label, emoji) label,
+#define RULES_EMOJI(id, label, emoji) emoji,
+
+#define RULES_IS_MOVE(n, a) ((a) >= 1 && (a) <= (n))
+#define RULES_CELL(n, a, b) \
+    ((!RULES_IS_MOVE(n, a) || !RULES_IS_MOVE(n, b) || (a) == (b)) ? 0 \
+     : (((a) - (b) + (n)) % (n) <= ((n) - 1) / 2) ? 1 : 2)
+#define RULES_ROW(n, a) \
+    { RULES_CELL(n, a, 0), RULES_CELL(n, a, 1), RULES_CELL(n, a, 2), RULES_CELL(n, a, 3), \
+      RULES_CELL(n, a, 4), RULES_CELL(n, a, 5), RULES_CELL(n, a, 6), RULES_CELL(n, a, 7) }
+#define RULES_OUTCOMES(n) \
+    { RULES_ROW(n, 0), RULES_ROW(n, 1), RULES_ROW(n, 2), RULES_ROW(n, 3), \
+      RULES_ROW(n, 4), RULES_ROW(n, 5), RULES_ROW(n, 6), RULES_ROW(n, 7) }
+/* the next move in the cycle beats this one */
+#define RULES_COUNTER(n, m) (RULES_IS_MOVE(n, m) ? (m) % (n) + 1 : 0)
+#define RULES_COUNTERS(n) \
+    { RULES_COUNTER(n, 0), RULES_COUNTER(n, 1), RULES_COUNTER(n, 2), RULES_COUNTER(n, 3), \
+      RULES_COUNTER(n, 4), RULES_COUNTER(n, 5), RULES_COUNTER(n, 6), RULES_COUNTER(n, 7) }
+
+#define RULE_SET(str, rid, LIST) { \
+    .name = str, \
+    .id = rid, \
+    .n_moves = 0 LIST(RULES_COUNT), \
+    .names = { NULL, LIST(RULES_NAME) }, \
+    .labels = { NULL, LIST(RULES_LABEL) }, \
+    .emoji = { NULL, LIST(RULES_EMOJI) }, \
+    .counter = RULES_COUNTERS(0 LIST(RULES_COUNT)), \
+    .outcome = RULES_OUTCOMES(0 LIST(RULES_COUNT)), \
+}
+
+_Static_assert(RULES_MAX_MOVES == 7, "outcome rows are spelled out for 8 columns");
+_Static_assert(CLASSIC_END - 1 == 3 && RPSLS_END % 2 == 0 && RPS7_END % 2 == 0,
+               "cyclic variants need an odd number of moves");
+_Static_assert(RPS7_END - 1 <= RULES_MAX_MOVES, "too many moves for RULES_MAX_MOVES");
+
+const RuleSet rule_sets[RULES_ID_COUNT] = {
+    [RULES_ID_CLASSIC] = RULE_SET("classic", RULES_ID_CLASSIC, RULES_CLASSIC),
+    [RULES_ID_RPSLS] = RULE_SET("rpsls", RULES_ID_RPSLS, RULES_RPSLS),
+    [RULES_ID_RPS7] = RULE_SET("rps7", RULES_ID_RPS7, RULES_RPS7),
+};
+
+const RuleSet *rules = &rule_sets[RULES_ID_CLASSIC];
+
+/* --- Selection --- */
+const RuleSet *rules_by_name(const char *name) {
+    if (!name) return NULL;
+    for (int i = 0; i < RULES_ID_COUNT; i++)
+        if (strcasecmp(rule_sets[i].name, name) == 0) return &rule_sets[i];
+    return NULL;
+}
+
+const RuleSet *rules_by_id(int id) {
+    return (id >= 0 && id < RULES_ID_COUNT) ? &rule_sets[id] : NULL;
+}
+
+const RuleSet *rules_select(const char *name) {
+    const RuleSet *r = rules_by_name(name);
+
+    if (r) rules = r;
+    return r;
+}
+
+int rules_select_from_env(void) {
+    const char *name = getenv("RPS_RULES");
+    return !name || !*name || rules_select(name) != NULL;
+}
+
+int rules_move_by_label(const RuleSet *r, const char *label) {
+    for (int m = 1; m <= r->n_moves; m++)
+        if (strcasecmp(r->labels[m], label) == 0) return m;
+    return 0;
+}
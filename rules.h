@@ -0,0 +1,112 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Cyclic rule sets (GTK-free)
+ * ----------------------------------------------------------------------------
+ * NOTE: Each variant is written once, as an X-macro list of its moves in
+ * cycle order: X(ID, "Label", "emoji"). Everything else is generated from
+ * that list at compile time -- the move enum, the name tables, the N x N
+ * outcome matrix and the counter-move table -- so deciding a round is one
+ * table load whatever the variant.
+ *
+ * All variants use the same balanced cyclic rule for an odd N: with moves
+ * numbered 1..N in list order, a beats b when (a - b) mod N is in
+ * 1..(N-1)/2, i.e. each move beats the (N-1)/2 moves listed before it
+ * (wrapping around). For N = 3 that is exactly outcome_of() in outcome.h.
+ *
+ * The active variant is chosen once at startup: RPS_RULES=classic|rpsls|rps7
+ * or rules_select(). Both sides of a networked game must agree on it.
+ */
+
+#ifndef RPS_RULES_H
+#define RPS_RULES_H
+
+#include <stdint.h>
+
+#define RULES_MAX_MOVES 7             /* moves fit in 3 bits, 1..7 */
+
+/* --- Variants --- */
+#define RULES_CLASSIC(X) \
+    X(ROCK, "Rock", "✊") \
+    X(PAPER, "Paper", "✋") \
+    X(SCISSORS, "Scissors", "✌️")
+
+/* Rock crushes lizard and scissors, Spock smashes scissors and vaporizes rock, ... */
+#define RULES_RPSLS(X) \
+    X(ROCK, "Rock", "✊") \
+    X(SPOCK, "Spock", "🖖") \
+    X(PAPER, "Paper", "✋") \
+    X(LIZARD, "Lizard", "🦎") \
+    X(SCISSORS, "Scissors", "✌️")
+
+/* RPS-7: rock beats fire, scissors and sponge; water beats rock, fire and scissors; ... */
+#define RULES_RPS7(X) \
+    X(ROCK, "Rock", "✊") \
+    X(WATER, "Water", "💧") \
+    X(AIR, "Air", "💨") \
+    X(PAPER, "Paper", "✋") \
+    X(SPONGE, "Sponge", "🧽") \
+    X(SCISSORS, "Scissors", "✌️") \
+    X(FIRE, "Fire", "🔥")
+
+/* Move constants per variant: CLASSIC_ROCK = 1, RPSLS_SPOCK = 2, RPS7_FIRE = 7, ... */
+#define RULES_ENUM_CLASSIC(id, label, emoji) CLASSIC_##id,
+#define RULES_ENUM_RPSLS(id, label, emoji) RPSLS_##id,
+#define RULES_ENUM_RPS7(id, label, emoji) RPS7_##id,
+enum { CLASSIC_NONE, RULES_CLASSIC(RULES_ENUM_CLASSIC) CLASSIC_END };
+enum { RPSLS_NONE, RULES_RPSLS(RULES_ENUM_RPSLS) RPSLS_END };
+enum { RPS7_NONE, RULES_RPS7(RULES_ENUM_RPS7) RPS7_END };
+
+/* --- Rule set --- */
+typedef enum {
+    RULES_ID_CLASSIC,
+    RULES_ID_RPSLS,
+    RULES_ID_RPS7,
+    RULES_ID_COUNT
+} RulesId;
+
+typedef struct {
+    const char *name;                 /* "classic", "rpsls", "rps7" */
+    RulesId id;
+    int n_moves;                      /* odd, 3..RULES_MAX_MOVES */
+    /* indexed by move, 1..n_moves; index 0 is "no move" */
+    const char *names[RULES_MAX_MOVES + 1];     /* "ROCK" */
+    const char *labels[RULES_MAX_MOVES + 1];    /* "Rock" */
+    const char *emoji[RULES_MAX_MOVES + 1];
+    uint8_t counter[RULES_MAX_MOVES + 1];       /* a move that beats this one */
+    /* RESULT_* for [player][computer]; rows and columns for invalid moves are draws */
+    uint8_t outcome[RULES_MAX_MOVES + 1][RULES_MAX_MOVES + 1];
+} RuleSet;
+
+extern const RuleSet rule_sets[RULES_ID_COUNT];
+/* The active variant; never NULL */
+extern const RuleSet *rules;
+
+/* Select the active variant by name; returns it, or NULL (and keeps the
+ * current one) if the name is unknown */
+const RuleSet *rules_select(const char *name);
+/* Apply RPS_RULES if set; returns 0 if it names no variant */
+int rules_select_from_env(void);
+const RuleSet *rules_by_name(const char *name);
+const RuleSet *rules_by_id(int id);
+
+static inline int rules_outcome(const RuleSet *r, int player_choice, int computer_choice) {
+    return r->outcome[player_choice & 7][computer_choice & 7];
+}
+
+static inline int rules_valid_move(const RuleSet *r, int choice) {
+    return choice >= 1 && choice <= r->n_moves;
+}
+
+/* One round in a byte: player | computer << 3 | result << 6 */
+static inline uint8_t rules_pack_round(int player_choice, int computer_choice, int result) {
+    return (uint8_t)((player_choice & 7) | (computer_choice & 7) << 3 | (result & 3) << 6);
+}
+static inline int rules_round_player(uint8_t packed) { return packed & 7; }
+static inline int rules_round_computer(uint8_t packed) { return (packed >> 3) & 7; }
+static inline int rules_round_result(uint8_t packed) { return packed >> 6; }
+
+/* Move by case-insensitive label ("rock", "Spock"); 0 if the variant has none */
+int rules_move_by_label(const RuleSet *r, const char *label);
+
+#endif /* RPS_RULES_H */
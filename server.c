@@ -0,0 +1,705 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Headless match server (Linux, GTK-free)
+ * ----------------------------------------------------------------------------
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "engine.h"
+#include "pool.h"
+#include "rng.h"
+#include "server.h"
+#include "session.h"
+
+#define MAX_EVENTS 256
+#define OUT_BUFFER 1024   /* a client that lets this much back up is dropped */
+#define NAME_MAX_LEN 31
+
+typedef struct Loop Loop;
+typedef struct Conn Conn;
+typedef struct Handoff Handoff;
+
+struct Conn {
+    int fd;
+    Loop *loop;
+    PoolHandle handle;          /* this record in loop->conns */
+    PackedGame game;            /* this client's view of the current match; name in loop->names */
+    Strategy *bot;              /* PLAY BOT opponent in bot_storage, NULL in human matches */
+    Conn *peer;                 /* human opponent (always on the same loop) */
+    uint64_t ticket;            /* nonzero while queued by PLAY HUMAN */
+    Handoff *moving;            /* set when it must move to its opponent's loop */
+    int pending_move;           /* human match: move sent, waiting for the peer */
+    int in_match;
+    int closed;                 /* freed at the end of the current event batch */
+    int overflow;               /* output buffer full: drop on next flush */
+    Conn *next_dead;
+    uint32_t events;            /* currently registered epoll events */
+    size_t in_len;
+    size_t out_len;
+    char in[SERVER_LINE_MAX * 2];
+    char out[OUT_BUFFER];
+    StrategyStorage bot_storage;
+};
+
+struct Loop {
+    int id;
+    int epfd;
+    int listen_fd;
+    const ServerConfig *config;
+    struct Lobby *lobby;        /* shared by all loops */
+    int handoff_fd;             /* eventfd: connections were handed to this loop */
+    pthread_mutex_t handoff_lock;
+    Handoff *handoffs;          /* under handoff_lock */
+    Conn *dead;                 /* closed this batch; other events may still point at them */
+    Pool conns;                 /* Conn records; accept/close never reach malloc once warm */
+    NameTable names;            /* interned HELLO names, loop-local so no locking */
+    uint32_t peak;              /* most connections open at once */
+    uint64_t sessions;          /* sessions accepted, also seeds the bots */
+    pthread_t thread;
+};
+
+/* The one client waiting for a human opponent, whichever loop it is on */
+typedef struct Lobby {
+    pthread_mutex_t lock;
+    Loop *loop;                 /* NULL: nobody waiting */
+    PoolHandle handle;
+    uint64_t ticket;            /* its Conn.ticket, so a reused handle does not match */
+    uint64_t next_ticket;
+} Lobby;
+
+/* A connection on its way to the loop its opponent waits on, with
+ * whatever it had buffered */
+struct Handoff {
+    Handoff *next;
+    Loop *target;
+    int fd;
+    PoolHandle opponent;
+    uint64_t opponent_ticket;
+    size_t in_len;
+    size_t out_len;
+    char name[NAME_MAX_LEN + 1];
+    char in[SERVER_LINE_MAX * 2];
+    char out[OUT_BUFFER];
+};
+
+static volatile sig_atomic_t server_stopping = 0;
+
+static void on_stop_signal(int sig) {
+    (void)sig;
+    server_stopping = 1;
+}
+
+/* --- Sockets --- */
+static int set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return (flags < 0) ? -1 : fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+/* Split "host:port" / ":port" / "port"; host may be empty (any interface) */
+static void split_address(const char *address, char *host, size_t host_size, char *port, size_t port_size) {
+    const char *colon = strrchr(address, ':');
+
+    if (!colon) {
+        host[0] = '\0';
+        snprintf(port, port_size, "%s", address[0] ? address : "7777");
+        return;
+    }
+    snprintf(host, host_size, "%.*s", (int)(colon - address), address);
+    snprintf(port, port_size, "%s", colon[1] ? colon + 1 : "7777");
+}
+
+static int open_socket(const char *address, int listening) {
+    int fd = -1;
+
+    if (strncmp(address, "unix:", 5) == 0) {
+        struct sockaddr_un sun;
+        memset(&sun, 0, sizeof(sun));
+        sun.sun_family = AF_UNIX;
+        snprintf(sun.sun_path, sizeof(sun.sun_path), "%s", address + 5);
+
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) return -1;
+        if (listening) {
+            unlink(sun.sun_path);
+            if (bind(fd, (struct sockaddr *)&sun, sizeof(sun)) < 0 || listen(fd, 4096) < 0) {
+                close(fd);
+                return -1;
+            }
+        } else if (connect(fd, (struct sockaddr *)&sun, sizeof(sun)) < 0) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    char host[256], port[16];
+    struct addrinfo hints, *res, *ai;
+    split_address(address, host, sizeof(host), port, sizeof(port));
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = listening ? AI_PASSIVE : 0;
+    if (getaddrinfo(host[0] ? host : NULL, port, &hints, &res) != 0) return -1;
+
+    for (ai = res; ai; ai = ai->ai_next) {
+        int one = 1;
+        fd = socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) continue;
+        if (listening) {
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+            if (bind(fd, ai->ai_addr, ai->ai_addrlen) == 0 && listen(fd, 4096) == 0) break;
+        } else if (connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            break;
+        }
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+    return fd;
+}
+
+int server_listen_socket(const char *address) {
+    int fd = open_socket(address, 1);
+    if (fd >= 0 && set_nonblocking(fd) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int server_connect_socket(const char *address) {
+    return open_socket(address, 0);
+}
+
+/* --- Output --- */
+static void conn_close(Conn *c);
+
+static void conn_set_events(Conn *c, uint32_t events) {
+    struct epoll_event ev;
+    if (c->events == events) return;
+    ev.events = events;
+    ev.data.ptr = c;
+    epoll_ctl(c->loop->epfd, EPOLL_CTL_MOD, c->fd, &ev);
+    c->events = events;
+}
+
+/* Write as much buffered output as the socket takes; arm EPOLLOUT for the rest */
+static int conn_flush(Conn *c) {
+    size_t sent = 0;
+
+    if (c->closed) return 0;
+    if (c->overflow) return -1;
+    while (sent < c->out_len) {
+        ssize_t n = send(c->fd, c->out + sent, c->out_len - sent, MSG_NOSIGNAL);
+        if (n > 0) { sent += (size_t)n; continue; }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        return -1;
+    }
+    memmove(c->out, c->out + sent, c->out_len - sent);
+    c->out_len -= sent;
+    conn_set_events(c, EPOLLIN | EPOLLRDHUP | (c->out_len ? EPOLLOUT : 0));
+    return 0;
+}
+
+/* Queue one formatted line; lines are flushed once per batch of input */
+static int conn_send(Conn *c, const char *format, ...) {
+    size_t room = sizeof(c->out) - c->out_len;
+    va_list args;
+    int n;
+
+    va_start(args, format);
+    n = vsnprintf(c->out + c->out_len, room, format, args);
+    va_end(args);
+    if (n < 0 || (size_t)n >= room) {
+        c->overflow = 1; /* slow reader: dropped by the next conn_flush() */
+        return -1;
+    }
+    c->out_len += (size_t)n;
+    return 0;
+}
+
+/* --- Matches --- */
+static const char *conn_name(const Conn *c) {
+    const char *name = name_lookup(&c->loop->names, c->game.name);
+    return name ? name : "anon";
+}
+
+static void match_start(Conn *c, Conn *peer, const char *opponent_name) {
+    packed_game_reset(&c->game);
+    c->peer = peer;
+    c->pending_move = 0;
+    c->in_match = 1;
+    char format[64];
+    conn_send(c, "START %s %s %s\n", opponent_name, match_format_spec(&match_format, format, sizeof(format)),
+              rules->name);
+}
+
+static void round_report(Conn *c, int result) {
+    GameState g;
+    packed_game_unpack(&c->game, &g);
+    conn_send(c, "ROUND %d %d %d %d %d %d\n", g.current_round - 1, g.last_player_choice,
+              g.last_computer_choice, result, g.player_score, g.computer_score);
+    if (game_is_over(&g)) {
+        conn_send(c, "MATCH %d %d %d\n", game_winner(&g), g.player_score, g.computer_score);
+        c->in_match = 0;
+        c->peer = NULL;
+    }
+}
+
+static void handle_move(Conn *c, int move) {
+    if (!c->in_match || !rules_valid_move(rules, move) || c->pending_move) {
+        conn_send(c, "ERR bad_move\n");
+        return;
+    }
+
+    if (c->bot) {
+        int bot_move = c->bot->choose(c->bot);
+        int result = packed_game_play_round(&c->game, move, bot_move);
+        if (c->bot->observe) c->bot->observe(c->bot, bot_move, move);
+        round_report(c, result);
+        return;
+    }
+
+    Conn *peer = c->peer;
+    if (!peer->pending_move) {
+        c->pending_move = move; /* first to move waits for the other */
+        return;
+    }
+    int peer_move = peer->pending_move;
+    c->pending_move = peer->pending_move = 0;
+    round_report(c, packed_game_play_round(&c->game, move, peer_move));
+    round_report(peer, packed_game_play_round(&peer->game, peer_move, move));
+    if (conn_flush(peer) < 0) conn_close(peer);
+}
+
+/* --- Human matchmaking ---
+ * Both sides of a match live on one loop, so a round never needs a lock.
+ * A client that finds its opponent waiting on another loop moves there:
+ * handle_play() only books the move, conn_run_lines() carries it out once
+ * the current line is done and loop_adopt() picks it up on the other side. */
+static void queue_human(Conn *c);
+
+static void leave_lobby(Conn *c) {
+    Lobby *lobby = c->loop->lobby;
+
+    if (!c->ticket) return;
+    pthread_mutex_lock(&lobby->lock);
+    if (lobby->loop && lobby->ticket == c->ticket) lobby->loop = NULL;
+    pthread_mutex_unlock(&lobby->lock);
+    c->ticket = 0;
+}
+
+/* Pair c with the client the lobby held, if it is still waiting */
+static void pair_humans(Conn *c, PoolHandle handle, uint64_t ticket) {
+    Conn *other = pool_get(&c->loop->conns, handle);
+
+    if (!other || other->closed || other->ticket != ticket) {
+        queue_human(c); /* it left, or took a bot match, in the meantime */
+        return;
+    }
+    other->ticket = 0;
+    match_start(c, other, conn_name(other));
+    match_start(other, c, conn_name(c));
+    if (conn_flush(other) < 0) conn_close(other);
+}
+
+static void queue_human(Conn *c) {
+    Loop *loop = c->loop, *other_loop;
+    Lobby *lobby = loop->lobby;
+    PoolHandle other_handle;
+    uint64_t other_ticket;
+    Handoff *h;
+
+    if (c->ticket) { /* still queued, or being paired right now */
+        conn_send(c, "WAIT\n");
+        return;
+    }
+    if (!(h = malloc(sizeof(*h)))) { /* taken before the lock: a booked opponent is never lost */
+        conn_send(c, "ERR busy\n");
+        return;
+    }
+    pthread_mutex_lock(&lobby->lock);
+    other_loop = lobby->loop;
+    other_handle = lobby->handle;
+    other_ticket = lobby->ticket;
+    if (other_loop) {
+        lobby->loop = NULL;
+    } else {
+        lobby->loop = loop;
+        lobby->handle = c->handle;
+        lobby->ticket = c->ticket = ++lobby->next_ticket;
+    }
+    pthread_mutex_unlock(&lobby->lock);
+
+    if (other_loop && other_loop != loop) {
+        h->target = other_loop;
+        h->opponent = other_handle;
+        h->opponent_ticket = other_ticket;
+        c->moving = h;
+        return;
+    }
+    free(h);
+    if (other_loop) pair_humans(c, other_handle, other_ticket);
+    else conn_send(c, "WAIT\n");
+}
+
+static void handle_play(Conn *c, const char *mode) {
+    Loop *loop = c->loop;
+
+    if (c->in_match) {
+        conn_send(c, "ERR in_match\n");
+        return;
+    }
+    if (strcmp(mode, "BOT") == 0) {
+        if (!c->bot) {
+            const char *name = loop->config->bot_strategy ? loop->config->bot_strategy : "markov";
+            c->bot = strategy_init(&c->bot_storage, name,
+                                   rng_derive_seed(loop->config->seed, ((uint64_t)loop->id << 40) ^ loop->sessions));
+            if (!c->bot) {
+                conn_send(c, "ERR no_bot\n");
+                return;
+            }
+        }
+        leave_lobby(c);
+        match_start(c, NULL, c->bot->name);
+    } else if (strcmp(mode, "HUMAN") == 0) {
+        c->bot = NULL;
+        queue_human(c);
+    } else {
+        conn_send(c, "ERR bad_mode\n");
+    }
+}
+
+/* Returns -1 when the connection should be closed */
+static int handle_line(Conn *c, char *line) {
+    if (strncmp(line, "MOVE ", 5) == 0) {
+        handle_move(c, atoi(line + 5));
+    } else if (strncmp(line, "HELLO ", 6) == 0) {
+        char *name = line + 6;
+        for (char *p = name; *p && p - name < NAME_MAX_LEN; p++) if (*p == ' ') *p = '_'; /* names stay one token */
+        uint32_t id = name_intern(&c->loop->names, name, NAME_MAX_LEN);
+        if (!id) {
+            conn_send(c, "ERR no_memory\n"); /* keep the old name rather than go anonymous */
+            return 0;
+        }
+        c->game.name = id;
+        conn_send(c, "WELCOME\n");
+    } else if (strncmp(line, "PLAY ", 5) == 0) {
+        handle_play(c, line + 5);
+    } else if (strcmp(line, "QUIT") == 0) {
+        return -1;
+    } else {
+        conn_send(c, "ERR unknown\n");
+    }
+    return 0;
+}
+
+/* --- Connection lifecycle --- */
+static void conn_close(Conn *c) {
+    Loop *loop = c->loop;
+
+    if (c->closed) return;
+    c->closed = 1;
+    leave_lobby(c);
+    free(c->moving);
+    c->moving = NULL;
+    if (c->peer) {
+        Conn *peer = c->peer;
+        peer->peer = NULL;
+        peer->in_match = 0;
+        peer->pending_move = 0;
+        conn_send(peer, "ERR opponent_left\n");
+        conn_flush(peer); /* best effort; a dead peer is found on its next event */
+    }
+    epoll_ctl(loop->epfd, EPOLL_CTL_DEL, c->fd, NULL);
+    close(c->fd);
+    c->next_dead = loop->dead;
+    loop->dead = c;
+}
+
+static void loop_reap(Loop *loop) {
+    while (loop->dead) {
+        Conn *c = loop->dead;
+        loop->dead = c->next_dead;
+        pool_free(&loop->conns, c->handle);
+    }
+}
+
+/* Hand c over to the loop its opponent waits on; here it is done with */
+static void conn_hand_off(Conn *c) {
+    Loop *loop = c->loop, *target;
+    Handoff *h = c->moving;
+    const char *name = name_lookup(&loop->names, c->game.name);
+
+    h->fd = c->fd;
+    snprintf(h->name, sizeof(h->name), "%s", name ? name : "");
+    h->in_len = c->in_len;
+    memcpy(h->in, c->in, c->in_len);
+    h->out_len = c->out_len;
+    memcpy(h->out, c->out, c->out_len);
+    epoll_ctl(loop->epfd, EPOLL_CTL_DEL, c->fd, NULL);
+    c->moving = NULL;
+    c->closed = 1; /* the record is freed with this batch, the socket lives on */
+    c->next_dead = loop->dead;
+    loop->dead = c;
+
+    target = h->target;
+    pthread_mutex_lock(&target->handoff_lock);
+    h->next = target->handoffs;
+    target->handoffs = h;
+    pthread_mutex_unlock(&target->handoff_lock);
+    eventfd_write(target->handoff_fd, 1);
+}
+
+/* Runs every complete line buffered; -1 once c was closed or moved away */
+static int conn_run_lines(Conn *c) {
+    char *start = c->in, *end = c->in + c->in_len, *nl;
+
+    while (!c->moving && (nl = memchr(start, '\n', (size_t)(end - start))) != NULL) {
+        *nl = '\0';
+        if (nl > start && nl[-1] == '\r') nl[-1] = '\0';
+        if (handle_line(c, start) < 0) {
+            conn_flush(c);
+            conn_close(c);
+            return -1;
+        }
+        start = nl + 1;
+    }
+    c->in_len = (size_t)(end - start);
+    memmove(c->in, start, c->in_len);
+    if (c->moving) {
+        conn_hand_off(c);
+        return -1;
+    }
+    return 0;
+}
+
+static void conn_readable(Conn *c) {
+    for (;;) {
+        ssize_t n = recv(c->fd, c->in + c->in_len, sizeof(c->in) - c->in_len, 0);
+        if (n == 0) { conn_close(c); return; }
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            conn_close(c);
+            return;
+        }
+        c->in_len += (size_t)n;
+        if (conn_run_lines(c) < 0) return;
+        if (c->in_len == sizeof(c->in)) { conn_close(c); return; } /* line too long */
+    }
+    if (conn_flush(c) < 0) conn_close(c);
+}
+
+static void loop_accept(Loop *loop) {
+    for (;;) {
+        int fd = accept4(loop->listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return; /* EAGAIN: another loop took it, or backlog drained */
+
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one)); /* fails harmlessly on unix sockets */
+
+        PoolHandle handle;
+        Conn *c = pool_alloc(&loop->conns, &handle);
+        if (!c) {
+            close(fd);
+            continue;
+        }
+        c->fd = fd;
+        c->loop = loop;
+        c->handle = handle;
+        c->events = EPOLLIN | EPOLLRDHUP;
+
+        struct epoll_event ev = { .events = c->events, .data.ptr = c };
+        if (epoll_ctl(loop->epfd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            close(fd);
+            pool_free(&loop->conns, handle);
+            continue;
+        }
+        loop->sessions++;
+        if (loop->conns.live > loop->peak) loop->peak = loop->conns.live;
+    }
+}
+
+/* Take in the connections other loops handed over and pair them up */
+static void loop_adopt(Loop *loop) {
+    eventfd_t count;
+    Handoff *h, *next;
+
+    eventfd_read(loop->handoff_fd, &count);
+    pthread_mutex_lock(&loop->handoff_lock);
+    h = loop->handoffs;
+    loop->handoffs = NULL;
+    pthread_mutex_unlock(&loop->handoff_lock);
+
+    for (; h; h = next) {
+        PoolHandle handle;
+        Conn *c = pool_alloc(&loop->conns, &handle);
+
+        next = h->next;
+        if (c) {
+            struct epoll_event ev = { .events = EPOLLIN | EPOLLRDHUP, .data.ptr = c };
+            c->fd = h->fd;
+            c->loop = loop;
+            c->handle = handle;
+            c->events = ev.events;
+            if (epoll_ctl(loop->epfd, EPOLL_CTL_ADD, h->fd, &ev) < 0) {
+                pool_free(&loop->conns, handle);
+                c = NULL;
+            }
+        }
+        if (!c) {
+            Conn *other = pool_get(&loop->conns, h->opponent);
+            close(h->fd);
+            if (other && !other->closed && other->ticket == h->opponent_ticket) {
+                other->ticket = 0; /* back in the lobby, not left booked */
+                queue_human(other);
+                if (conn_run_lines(other) == 0 && conn_flush(other) < 0) conn_close(other);
+            }
+            free(h);
+            continue;
+        }
+        if (h->name[0]) c->game.name = name_intern(&loop->names, h->name, NAME_MAX_LEN);
+        c->in_len = h->in_len;
+        memcpy(c->in, h->in, h->in_len);
+        c->out_len = h->out_len;
+        memcpy(c->out, h->out, h->out_len);
+        if (loop->conns.live > loop->peak) loop->peak = loop->conns.live;
+
+        pair_humans(c, h->opponent, h->opponent_ticket);
+        free(h);
+        if (conn_run_lines(c) == 0 && conn_flush(c) < 0) conn_close(c);
+    }
+}
+
+static void *loop_main(void *arg) {
+    Loop *loop = arg;
+    struct epoll_event events[MAX_EVENTS];
+
+    while (!server_stopping) {
+        int n = epoll_wait(loop->epfd, events, MAX_EVENTS, 500);
+        for (int i = 0; i < n; i++) {
+            Conn *c = events[i].data.ptr;
+            if (!c) {
+                loop_accept(loop);
+                continue;
+            }
+            if (events[i].data.ptr == loop) {
+                loop_adopt(loop);
+                continue;
+            }
+            if (c->closed) continue;
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                conn_close(c);
+                continue;
+            }
+            if (events[i].events & EPOLLOUT) {
+                if (conn_flush(c) < 0) { conn_close(c); continue; }
+            }
+            if (events[i].events & (EPOLLIN | EPOLLRDHUP)) conn_readable(c);
+        }
+        loop_reap(loop);
+    }
+    return NULL;
+}
+
+/* --- Entry point --- */
+int server_run(const ServerConfig *config) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int n_loops = config->loops > 0 ? config->loops : (cores > 0 ? (int)cores : 1);
+    struct rlimit rl;
+    Lobby lobby = { .lock = PTHREAD_MUTEX_INITIALIZER };
+    Loop *loops;
+    int listen_fd;
+
+    /* tens of thousands of sessions need as many descriptors as we may have */
+    if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur < rl.rlim_max) {
+        rl.rlim_cur = rl.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &rl);
+    }
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGINT, on_stop_signal);
+    signal(SIGTERM, on_stop_signal);
+
+    listen_fd = server_listen_socket(config->address);
+    if (listen_fd < 0) {
+        fprintf(stderr, "server: cannot listen on %s: %s\n", config->address, strerror(errno));
+        return -1;
+    }
+
+    loops = calloc((size_t)n_loops, sizeof(Loop));
+    if (!loops) {
+        close(listen_fd);
+        return -1;
+    }
+    for (int i = 0; i < n_loops; i++) {
+        struct epoll_event ev = { .events = EPOLLIN | EPOLLEXCLUSIVE, .data.ptr = NULL };
+        struct epoll_event handoff_ev = { .events = EPOLLIN, .data.ptr = &loops[i] };
+        loops[i].id = i;
+        loops[i].config = config;
+        loops[i].listen_fd = listen_fd;
+        loops[i].lobby = &lobby;
+        loops[i].epfd = epoll_create1(EPOLL_CLOEXEC);
+        loops[i].handoff_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        pthread_mutex_init(&loops[i].handoff_lock, NULL);
+        pool_init(&loops[i].conns, sizeof(Conn));
+        name_table_init(&loops[i].names);
+        epoll_ctl(loops[i].epfd, EPOLL_CTL_ADD, listen_fd, &ev);
+        epoll_ctl(loops[i].epfd, EPOLL_CTL_ADD, loops[i].handoff_fd, &handoff_ev);
+        pthread_create(&loops[i].thread, NULL, loop_main, &loops[i]);
+    }
+    fprintf(stderr, "server: listening on %s with %d loops\n", config->address, n_loops);
+
+    uint64_t total = 0;
+    for (int i = 0; i < n_loops; i++) {
+        Loop *loop = &loops[i];
+        pthread_join(loop->thread, NULL);
+        close(loop->epfd);
+    }
+    for (int i = 0; i < n_loops; i++) {
+        Loop *loop = &loops[i];
+        /* all stopped: nothing can be handed over any more */
+        while (loop->handoffs) {
+            Handoff *h = loop->handoffs;
+            loop->handoffs = h->next;
+            close(h->fd);
+            free(h);
+        }
+        close(loop->handoff_fd);
+        pthread_mutex_destroy(&loop->handoff_lock);
+        total += loop->sessions;
+        if (loop->peak)
+            fprintf(stderr, "server: loop %d peak %u sessions, %zu bytes/session (%zu of game state), %zu KiB reserved\n",
+                    i, loop->peak, loop->conns.record_size + 1, sizeof(PackedGame),
+                    (pool_bytes(&loop->conns) + loop->names.bytes) / 1024);
+        pool_destroy(&loop->conns);
+        name_table_destroy(&loop->names);
+    }
+    fprintf(stderr, "server: stopped after %llu sessions\n", (unsigned long long)total);
+
+    close(listen_fd);
+    if (strncmp(config->address, "unix:", 5) == 0) unlink(config->address + 5);
+    free(loops);
+    pthread_mutex_destroy(&lobby.lock);
+    return 0;
+}
@@ -0,0 +1,54 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Headless match server (Linux, GTK-free)
+ * ----------------------------------------------------------------------------
+ * NOTE: One non-blocking epoll loop per core, all waiting on the same
+ * listening socket (EPOLLEXCLUSIVE, so a new client wakes one loop). A
+ * connection stays on the loop that accepted it, so no session state is
+ * shared between threads. The exception is PLAY HUMAN: the one client
+ * waiting for an opponent is held in a lobby shared by all loops (under a
+ * mutex), and whoever pairs with it from another loop is handed over to
+ * that loop, so both sides of a match still share one.
+ *
+ * Protocol: one ASCII line per message.
+ *   client -> server   HELLO <name>
+ *                      PLAY BOT | PLAY HUMAN
+ *                      MOVE <1..3>
+ *                      QUIT
+ *   server -> client   WELCOME
+ *                      WAIT                        (queued for a human opponent)
+ *                      START <opponent> <format> <rules>
+ *                                                  (match_format_spec() and the rule set's
+ *                                                  name, e.g. best-of-3 classic)
+ *                      ROUND <n> <you> <them> <result> <your_score> <their_score>
+ *                      MATCH <result> <your_score> <their_score>
+ *                      ERR <reason>
+ * Results are the engine's codes from the receiver's side: 0 draw, 1 you, 2 them.
+ * MATCH follows the ROUND that decided the match, which may come before
+ * the format's last round.
+ */
+
+#ifndef RPS_SERVER_H
+#define RPS_SERVER_H
+
+#include <stdint.h>
+
+#define SERVER_DEFAULT_PORT 7777
+#define SERVER_LINE_MAX 128
+
+typedef struct {
+    const char *address;        /* "host:port", ":port" or "unix:/path" */
+    int loops;                  /* 0 = one per online core */
+    const char *bot_strategy;   /* registry name for PLAY BOT, default "markov" */
+    uint64_t seed;
+} ServerConfig;
+
+/* Runs until SIGINT/SIGTERM; returns 0 on clean shutdown, -1 on setup error */
+int server_run(const ServerConfig *config);
+
+/* Shared with clients: parse an address into a connected/listening socket */
+int server_listen_socket(const char *address);
+int server_connect_socket(const char *address);
+
+#endif /* RPS_SERVER_H */
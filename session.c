@@ -0,0 +1,206 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Packed game sessions and interned player names
+ * ----------------------------------------------------------------------------
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "session.h"
+
+#define NAME_CHUNK_SIZE 16384
+
+/* --- Packed game state --- */
+void packed_game_reset(PackedGame *g) {
+    uint32_t name = g->name;
+    memset(g, 0, sizeof(*g));
+    g->name = name;
+    g->round = 1;
+}
+
+int packed_game_play_round(PackedGame *g, int player_choice, int computer_choice) {
+    int result = decide_round(player_choice, computer_choice);
+
+    g->player_score += (result == RESULT_PLAYER_WIN);
+    g->computer_score += (result == RESULT_COMPUTER_WIN);
+    g->last = rules_pack_round(player_choice, computer_choice, result);
+    g->round++;
+    return result;
+}
+
+void packed_game_unpack(const PackedGame *g, GameState *out) {
+    out->current_round = g->round;
+    out->player_score = g->player_score;
+    out->computer_score = g->computer_score;
+    out->last_player_choice = packed_game_last_player(g);
+    out->last_computer_choice = packed_game_last_computer(g);
+    out->last_result = packed_game_last_result(g);
+}
+
+void packed_game_pack(PackedGame *g, const GameState *in) {
+    g->round = (uint8_t)in->current_round;
+    g->player_score = (uint8_t)in->player_score;
+    g->computer_score = (uint8_t)in->computer_score;
+    g->last = rules_pack_round(in->last_player_choice, in->last_computer_choice, in->last_result);
+}
+
+/* --- Name interning --- */
+static uint32_t name_hash(const char *s, size_t len) {
+    uint32_t h = 2166136261u; /* FNV-1a */
+    for (size_t i = 0; i < len; i++) h = (h ^ (unsigned char)s[i]) * 16777619u;
+    return h;
+}
+
+void name_table_init(NameTable *t) {
+    memset(t, 0, sizeof(*t));
+}
+
+void name_table_destroy(NameTable *t) {
+    for (uint32_t i = 0; i < t->n_chunks; i++) free(t->chunks[i]);
+    free(t->chunks);
+    free(t->slots);
+    free(t->names);
+    free(t->hashes);
+    memset(t, 0, sizeof(*t));
+}
+
+/* Keep the slot array at most half full */
+static int name_table_rehash(NameTable *t) {
+    uint32_t n_slots = t->slot_mask ? (t->slot_mask + 1) * 2 : 64;
+    uint32_t *slots = calloc(n_slots, sizeof(*slots));
+
+    if (!slots) return -1;
+    for (uint32_t id = 1; id <= t->count; id++) {
+        uint32_t i = t->hashes[id] & (n_slots - 1);
+        while (slots[i]) i = (i + 1) & (n_slots - 1);
+        slots[i] = id;
+    }
+    free(t->slots);
+    t->slots = slots;
+    t->slot_mask = n_slots - 1;
+    return 0;
+}
+
+/* Start a chunk with room for at least `size` bytes */
+static int name_chunk_add(NameTable *t, size_t size) {
+    char **chunks = realloc(t->chunks, (t->n_chunks + 1) * sizeof(*chunks));
+
+    if (!chunks) return -1;
+    t->chunks = chunks;
+    if (size < NAME_CHUNK_SIZE) size = NAME_CHUNK_SIZE;
+    if (!(chunks[t->n_chunks] = malloc(size))) return -1;
+    t->n_chunks++;
+    t->chunk_used = 0;
+    t->chunk_size = size;
+    t->bytes += size;
+    return 0;
+}
+
+static int name_ids_grow(NameTable *t, uint32_t cap) {
+    const char **names = realloc(t->names, cap * sizeof(*names));
+    if (!names) return -1;
+    t->names = names;
+    uint32_t *hashes = realloc(t->hashes, cap * sizeof(*hashes));
+    if (!hashes) return -1;
+    t->hashes = hashes;
+    t->capacity = cap;
+    return 0;
+}
+
+static char *name_store(NameTable *t, const char *name, size_t len) {
+    char *copy;
+
+    if ((!t->n_chunks || t->chunk_used + len + 1 > t->chunk_size) && name_chunk_add(t, len + 1) < 0) return NULL;
+    copy = t->chunks[t->n_chunks - 1] + t->chunk_used;
+    memcpy(copy, name, len);
+    copy[len] = '\0';
+    t->chunk_used += len + 1;
+    return copy;
+}
+
+int name_table_reserve(NameTable *t, uint32_t names, size_t bytes) {
+    uint64_t want = (uint64_t)t->count + names;
+
+    if (want + 2 > UINT32_MAX / 2) return -1;
+    while (!t->slots || want * 2 > t->slot_mask)
+        if (name_table_rehash(t) < 0) return -1;
+    if (want + 2 > t->capacity && name_ids_grow(t, (uint32_t)want + 2) < 0) return -1;
+    if (bytes && (!t->n_chunks || t->chunk_used + bytes > t->chunk_size)) return name_chunk_add(t, bytes);
+    return 0;
+}
+
+uint32_t name_intern(NameTable *t, const char *name, size_t len) {
+    uint32_t h, i;
+    const char *copy;
+
+    len = strnlen(name, len);
+    h = name_hash(name, len);
+    if (t->slots) {
+        for (i = h & t->slot_mask; t->slots[i]; i = (i + 1) & t->slot_mask) {
+            uint32_t id = t->slots[i];
+            if (t->hashes[id] == h && strncmp(t->names[id], name, len) == 0 && t->names[id][len] == '\0')
+                return id;
+        }
+    }
+
+    if ((t->count + 1) * 2 > t->slot_mask && name_table_rehash(t) < 0) return 0;
+    if (t->count + 1 >= t->capacity && name_ids_grow(t, t->capacity ? t->capacity * 2 : 64) < 0) return 0;
+    if (!(copy = name_store(t, name, len))) return 0;
+
+    t->count++;
+    t->names[t->count] = copy;
+    t->hashes[t->count] = h;
+    for (i = h & t->slot_mask; t->slots[i]; i = (i + 1) & t->slot_mask) {}
+    t->slots[i] = t->count;
+    return t->count;
+}
+
+const char *name_lookup(const NameTable *t, uint32_t id) {
+    return (id && id <= t->count) ? t->names[id] : NULL;
+}
+
+/* --- Session table --- */
+void session_table_init(SessionTable *t) {
+    pool_init(&t->games, sizeof(PackedGame));
+    name_table_init(&t->names);
+}
+
+void session_table_destroy(SessionTable *t) {
+    pool_destroy(&t->games);
+    name_table_destroy(&t->names);
+}
+
+int session_table_reserve(SessionTable *t, uint32_t sessions, uint32_t names, size_t name_bytes) {
+    if (pool_reserve(&t->games, sessions) < 0) return -1;
+    return name_table_reserve(&t->names, names, name_bytes);
+}
+
+SessionHandle session_create(SessionTable *t, const char *player_name) {
+    SessionHandle h;
+    PackedGame *g = pool_alloc(&t->games, &h);
+
+    if (!g) return POOL_NULL_HANDLE;
+    g->name = player_name ? name_intern(&t->names, player_name, SIZE_MAX) : 0;
+    if (player_name && !g->name) {
+        pool_free(&t->games, h); /* out of memory for the name: no silently anonymous player */
+        return POOL_NULL_HANDLE;
+    }
+    packed_game_reset(g);
+    return h;
+}
+
+void session_destroy(SessionTable *t, SessionHandle h) {
+    pool_free(&t->games, h);
+}
+
+PackedGame *session_get(const SessionTable *t, SessionHandle h) {
+    return pool_get(&t->games, h);
+}
+
+double session_table_bytes_per_session(const SessionTable *t) {
+    size_t names = t->names.bytes + (size_t)(t->names.slot_mask + 1) * sizeof(uint32_t)
+                   + (size_t)t->names.capacity * (sizeof(char *) + sizeof(uint32_t));
+    if (!t->names.slots) names = 0;
+    return t->games.live ? (double)(pool_bytes(&t->games) + names) / (double)t->games.live : 0.0;
+}
@@ -0,0 +1,91 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Packed game sessions and interned player names (GTK-free)
+ * ----------------------------------------------------------------------------
+ * NOTE: GameState is the convenient, int-per-field view the GUI works with.
+ * Servers and simulations that keep millions of matches alive use the
+ * 8-byte PackedGame instead; names are stored once in a NameTable and
+ * referenced by a 32-bit id. A SessionTable hands out PackedGames from a
+ * Pool, so creating or ending a session never reaches malloc once the
+ * pool and the name table have room (see session_table_reserve()).
+ */
+
+#ifndef RPS_SESSION_H
+#define RPS_SESSION_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "engine.h"
+#include "pool.h"
+
+/* --- Packed game state --- */
+typedef struct {
+    uint32_t name;              /* NameTable id of the player, 0 = anonymous */
+    uint8_t round;              /* 1-based, one past the last round once the match is over */
+    uint8_t player_score;
+    uint8_t computer_score;
+    uint8_t last;               /* last round, rules_pack_round() */
+} PackedGame;
+
+_Static_assert(sizeof(PackedGame) == 8, "PackedGame should stay 8 bytes");
+
+void packed_game_reset(PackedGame *g);
+int packed_game_play_round(PackedGame *g, int player_choice, int computer_choice);
+void packed_game_unpack(const PackedGame *g, GameState *out);
+void packed_game_pack(PackedGame *g, const GameState *in);
+
+static inline int packed_game_last_player(const PackedGame *g) { return rules_round_player(g->last); }
+static inline int packed_game_last_computer(const PackedGame *g) { return rules_round_computer(g->last); }
+static inline int packed_game_last_result(const PackedGame *g) { return rules_round_result(g->last); }
+static inline int packed_game_is_over(const PackedGame *g) {
+    return match_format_decided(&match_format, g->player_score, g->computer_score, g->round - 1);
+}
+
+/* --- Name interning --- */
+typedef struct {
+    uint32_t *slots;            /* open addressing over ids, 0 = empty */
+    uint32_t slot_mask;
+    uint32_t count;             /* ids 1..count are in use */
+    uint32_t capacity;
+    const char **names;         /* id -> interned string */
+    uint32_t *hashes;           /* id -> hash, so growing never rehashes strings */
+    char **chunks;              /* string storage, never moved */
+    uint32_t n_chunks;
+    size_t chunk_used;
+    size_t chunk_size;
+    size_t bytes;
+} NameTable;
+
+void name_table_init(NameTable *t);
+void name_table_destroy(NameTable *t);
+/* Room for `names` more names totalling `bytes` (NULs included) without allocating; -1 on OOM */
+int name_table_reserve(NameTable *t, uint32_t names, size_t bytes);
+/* Id for `name` (at most `len` bytes of it), interning it on first sight; 0 on OOM */
+uint32_t name_intern(NameTable *t, const char *name, size_t len);
+const char *name_lookup(const NameTable *t, uint32_t id);
+
+/* --- Session table --- */
+typedef PoolHandle SessionHandle;
+
+typedef struct {
+    Pool games;
+    NameTable names;
+} SessionTable;
+
+void session_table_init(SessionTable *t);
+void session_table_destroy(SessionTable *t);
+/* Pool room for `sessions` and name room as name_table_reserve(); -1 on OOM */
+int session_table_reserve(SessionTable *t, uint32_t sessions, uint32_t names, size_t name_bytes);
+
+/* New session in its first round; POOL_NULL_HANDLE when out of memory,
+ * including when a new `player_name` cannot be interned */
+SessionHandle session_create(SessionTable *t, const char *player_name);
+void session_destroy(SessionTable *t, SessionHandle h);
+/* NULL for a destroyed session, even if its slot was reused */
+PackedGame *session_get(const SessionTable *t, SessionHandle h);
+
+/* Bytes per live session, pool slabs and name storage included */
+double session_table_bytes_per_session(const SessionTable *t);
+
+#endif /* RPS_SESSION_H */
@@ -0,0 +1,439 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Matrix-game solver
+ * ----------------------------------------------------------------------------
+ */
+
+#define _GNU_SOURCE
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "rng.h"
+#include "solver.h"
+
+#define DEFAULT_CHECK_EVERY 16
+#define DEFAULT_MAX_ITERATIONS 1000000
+#define AUTO_THREAD_CELLS 65536       /* matrix cells per worker before "0 threads" adds another */
+
+/* Compile the two kernels for AVX2 as well and pick at load time */
+#if defined(__x86_64__) && defined(__GNUC__) && defined(__linux__)
+#define SOLVER_KERNEL __attribute__((target_clones("avx2", "default")))
+#else
+#define SOLVER_KERNEL
+#endif
+
+/* Partial sums each worker publishes before a barrier */
+enum {
+    PART_ROW_EV,
+    PART_ROW_POSITIVE,
+    PART_COL_EV,
+    PART_COL_POSITIVE,
+    PART_BEST_ROW,
+    PART_BEST_COL,
+    PART_COUNT
+};
+
+typedef struct Solve Solve;
+
+typedef struct {
+    Solve *solve;
+    int row_lo, row_hi;
+    int col_lo, col_hi;               /* col_lo is a multiple of SOLVER_ALIGN */
+    double part[PART_COUNT];
+    pthread_t thread;
+} SolverWorker;
+
+struct Solve {
+    const PayoffMatrix *m;
+    const SolverConfig *config;
+    int check_every;
+    float *x, *y;                     /* current mixes */
+    double *sum_x, *sum_y;            /* mixes weighted by iteration number; double, as t grows large */
+    float *avg_x, *avg_y;             /* the normalised averages, refreshed at each check */
+    float *row_regret, *col_regret;
+    float *u, *v;                     /* A y and x^T A, then the predicted positive regrets */
+    SolverWorker *workers;
+    int n_workers;
+    pthread_barrier_t barrier;
+    pthread_mutex_t start_lock;
+    pthread_cond_t start_cond;
+    int start;                        /* 0 waiting, 1 go, -1 abandon (a thread failed to start) */
+    uint64_t iterations;
+    double gap;
+};
+
+/* --- Allocation --- */
+static int round_up(int n) {
+    return (n + SOLVER_ALIGN - 1) / SOLVER_ALIGN * SOLVER_ALIGN;
+}
+
+static float *alloc_floats(size_t n) {
+    size_t bytes = (n * sizeof(float) + 31) / 32 * 32;
+    float *p = aligned_alloc(32, bytes ? bytes : 32);
+    if (p) memset(p, 0, bytes);
+    return p;
+}
+
+int payoff_init(PayoffMatrix *m, int rows, int cols) {
+    memset(m, 0, sizeof(*m));
+    if (rows <= 0 || cols <= 0) return -1;
+    m->rows = rows;
+    m->cols = cols;
+    m->stride = round_up(cols);
+    m->a = alloc_floats((size_t)rows * (size_t)m->stride);
+    return m->a ? 0 : -1;
+}
+
+void payoff_free(PayoffMatrix *m) {
+    free(m->a);
+    memset(m, 0, sizeof(*m));
+}
+
+int payoff_from_rules(PayoffMatrix *m, const RuleSet *r, const float *win_weights) {
+    if (payoff_init(m, r->n_moves, r->n_moves) < 0) return -1;
+    for (int p = 1; p <= r->n_moves; p++) {
+        for (int c = 1; c <= r->n_moves; c++) {
+            int o = rules_outcome(r, p, c);
+            float win = win_weights ? win_weights[p - 1] : 1.0f;
+            float loss = win_weights ? win_weights[c - 1] : 1.0f;
+            m->a[(size_t)(p - 1) * (size_t)m->stride + (size_t)(c - 1)] = (o == 1) ? win : (o == 2) ? -loss : 0.0f;
+        }
+    }
+    return 0;
+}
+
+int payoff_random(PayoffMatrix *m, int rows, int cols, uint64_t seed) {
+    Rng rng;
+
+    if (payoff_init(m, rows, cols) < 0) return -1;
+    rng_seed(&rng, seed);
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < cols; j++)
+            m->a[(size_t)i * (size_t)m->stride + (size_t)j] = (float)((double)(rng_next(&rng) >> 11) * 0x1p-52 - 1.0);
+    return 0;
+}
+
+/* --- Kernels --- */
+/* out[i] = (A y)_i for rows [lo, hi). Eight independent partial sums, so
+ * the dot product vectorises without reassociating a single float sum. */
+SOLVER_KERNEL
+static void row_values(const PayoffMatrix *m, const float *restrict y, int lo, int hi, float *restrict out) {
+    for (int i = lo; i < hi; i++) {
+        const float *restrict a = m->a + (size_t)i * (size_t)m->stride;
+        float acc[SOLVER_ALIGN] = { 0 };
+        for (int j = 0; j < m->stride; j += SOLVER_ALIGN)
+            for (int k = 0; k < SOLVER_ALIGN; k++) acc[k] += a[j + k] * y[j + k];
+        float sum = 0.0f;
+        for (int k = 0; k < SOLVER_ALIGN; k++) sum += acc[k];
+        out[i] = sum;
+    }
+}
+
+/* out[j] = (x^T A)_j for columns [lo, hi): one axpy per row */
+SOLVER_KERNEL
+static void col_values(const PayoffMatrix *m, const float *restrict x, int lo, int hi, float *restrict out) {
+    for (int j = lo; j < hi; j++) out[j] = 0.0f;
+    for (int i = 0; i < m->rows; i++) {
+        const float *restrict a = m->a + (size_t)i * (size_t)m->stride;
+        float xi = x[i];
+        if (xi == 0.0f) continue; /* RM+ mixes are often sparse */
+        for (int j = lo; j < hi; j++) out[j] += xi * a[j];
+    }
+}
+
+/* --- Self-play --- */
+static void sync_workers(Solve *s) {
+    if (s->n_workers > 1) pthread_barrier_wait(&s->barrier);
+}
+
+static double sum_parts(const Solve *s, int part) {
+    double sum = 0.0;
+    for (int w = 0; w < s->n_workers; w++) sum += s->workers[w].part[part];
+    return sum;
+}
+
+/* Gap of the averaged mixes after t iterations; every worker computes the same value */
+static double check_gap(Solve *s, SolverWorker *w, uint64_t t) {
+    const PayoffMatrix *m = s->m;
+    double best_row = -INFINITY, best_col = INFINITY;
+    double weight = (double)t * (double)(t + 1) / 2.0;
+
+    for (int i = w->row_lo; i < w->row_hi; i++) s->avg_x[i] = (float)(s->sum_x[i] / weight);
+    for (int j = w->col_lo; j < w->col_hi && j < m->cols; j++) s->avg_y[j] = (float)(s->sum_y[j] / weight);
+    sync_workers(s);
+
+    row_values(m, s->avg_y, w->row_lo, w->row_hi, s->u);
+    for (int i = w->row_lo; i < w->row_hi; i++) best_row = fmax(best_row, s->u[i]);
+    col_values(m, s->avg_x, w->col_lo, w->col_hi, s->v);
+    for (int j = w->col_lo; j < w->col_hi && j < m->cols; j++) best_col = fmin(best_col, s->v[j]);
+    w->part[PART_BEST_ROW] = best_row;
+    w->part[PART_BEST_COL] = best_col;
+    sync_workers(s);
+
+    best_row = -INFINITY;
+    best_col = INFINITY;
+    for (int k = 0; k < s->n_workers; k++) {
+        best_row = fmax(best_row, s->workers[k].part[PART_BEST_ROW]);
+        best_col = fmin(best_col, s->workers[k].part[PART_BEST_COL]);
+    }
+    return best_row - best_col;
+}
+
+static void solve_worker(SolverWorker *w) {
+    Solve *s = w->solve;
+    const PayoffMatrix *m = s->m;
+    uint64_t max_iterations = s->config->max_iterations ? s->config->max_iterations : DEFAULT_MAX_ITERATIONS;
+
+    for (uint64_t t = 1;; t++) {
+        double ev, total, part;
+
+        /* rows: regrets against the current column mix */
+        row_values(m, s->y, w->row_lo, w->row_hi, s->u);
+        part = 0.0;
+        for (int i = w->row_lo; i < w->row_hi; i++) part += (double)s->x[i] * s->u[i];
+        w->part[PART_ROW_EV] = part;
+        sync_workers(s);
+
+        /* RM+ keeps regrets clipped at 0; the next mix is played from the
+         * regrets plus this round's instantaneous regret as a prediction of
+         * the next one (predictive RM+), which damps the cycling plain
+         * regret matching shows on rock-paper-scissors-like games */
+        ev = sum_parts(s, PART_ROW_EV);
+        part = 0.0;
+        for (int i = w->row_lo; i < w->row_hi; i++) {
+            float inst = s->u[i] - (float)ev;
+            float r = s->row_regret[i] + inst;
+            s->row_regret[i] = (r > 0.0f) ? r : 0.0f;
+            r = s->row_regret[i] + inst;
+            s->u[i] = (r > 0.0f) ? r : 0.0f;
+            part += s->u[i];
+        }
+        w->part[PART_ROW_POSITIVE] = part;
+        sync_workers(s);
+
+        total = sum_parts(s, PART_ROW_POSITIVE);
+        for (int i = w->row_lo; i < w->row_hi; i++) {
+            s->x[i] = (total > 0.0) ? (float)(s->u[i] / total) : 1.0f / (float)m->rows;
+            s->sum_x[i] += (double)t * s->x[i]; /* linear averaging */
+        }
+        sync_workers(s);
+
+        /* columns: regrets against the row mix just computed (alternating
+         * updates); the column player's payoff is -A */
+        col_values(m, s->x, w->col_lo, w->col_hi, s->v);
+        part = 0.0;
+        for (int j = w->col_lo; j < w->col_hi; j++) part += (double)s->y[j] * s->v[j];
+        w->part[PART_COL_EV] = part;
+        sync_workers(s);
+
+        ev = sum_parts(s, PART_COL_EV);
+        part = 0.0;
+        for (int j = w->col_lo; j < w->col_hi && j < m->cols; j++) {
+            float inst = (float)ev - s->v[j];
+            float r = s->col_regret[j] + inst;
+            s->col_regret[j] = (r > 0.0f) ? r : 0.0f;
+            r = s->col_regret[j] + inst;
+            s->v[j] = (r > 0.0f) ? r : 0.0f;
+            part += s->v[j];
+        }
+        w->part[PART_COL_POSITIVE] = part;
+        sync_workers(s);
+
+        total = sum_parts(s, PART_COL_POSITIVE);
+        for (int j = w->col_lo; j < w->col_hi && j < m->cols; j++) {
+            s->y[j] = (total > 0.0) ? (float)(s->v[j] / total) : 1.0f / (float)m->cols;
+            s->sum_y[j] += (double)t * s->y[j];
+        }
+        sync_workers(s);
+
+        if (t % (uint64_t)s->check_every == 0 || t == max_iterations) {
+            double gap = check_gap(s, w, t);
+            if (gap < s->config->epsilon || t == max_iterations) {
+                if (w == s->workers) {
+                    s->gap = gap;
+                    s->iterations = t;
+                }
+                return;
+            }
+        }
+    }
+}
+
+static void *solve_thread(void *arg) {
+    SolverWorker *w = arg;
+    Solve *s = w->solve;
+    int start;
+
+    pthread_mutex_lock(&s->start_lock);
+    while (s->start == 0) pthread_cond_wait(&s->start_cond, &s->start_lock);
+    start = s->start;
+    pthread_mutex_unlock(&s->start_lock);
+    if (start > 0) solve_worker(w);
+    return NULL;
+}
+
+static void set_start(Solve *s, int start) {
+    pthread_mutex_lock(&s->start_lock);
+    s->start = start;
+    pthread_cond_broadcast(&s->start_cond);
+    pthread_mutex_unlock(&s->start_lock);
+}
+
+static int pick_threads(const PayoffMatrix *m, int requested) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    long cells = (long)m->rows * m->stride;
+    int n = requested;
+
+    if (n <= 0) {
+        n = (int)(cells / AUTO_THREAD_CELLS);
+        if (n > cores) n = (int)cores;
+    }
+    if (n > m->rows) n = m->rows;
+    if (n > m->stride / SOLVER_ALIGN) n = m->stride / SOLVER_ALIGN;
+    return (n > 0) ? n : 1;
+}
+
+static void partition(Solve *s) {
+    int n = s->n_workers, col_blocks = s->m->stride / SOLVER_ALIGN;
+
+    for (int w = 0; w < n; w++) {
+        SolverWorker *worker = &s->workers[w];
+        worker->solve = s;
+        worker->row_lo = (int)((long)s->m->rows * w / n);
+        worker->row_hi = (int)((long)s->m->rows * (w + 1) / n);
+        worker->col_lo = col_blocks * w / n * SOLVER_ALIGN;
+        worker->col_hi = col_blocks * (w + 1) / n * SOLVER_ALIGN;
+    }
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/* --- Public API --- */
+int solver_run(const PayoffMatrix *m, const SolverConfig *config, SolverResult *result) {
+    Solve s;
+    int rc = 0, started = 0;
+    double t0;
+
+    memset(result, 0, sizeof(*result));
+    memset(&s, 0, sizeof(s));
+    s.m = m;
+    s.config = config;
+    s.check_every = (config->check_every > 0) ? config->check_every : DEFAULT_CHECK_EVERY;
+    s.n_workers = pick_threads(m, config->threads);
+    s.x = alloc_floats((size_t)m->rows);
+    s.avg_x = alloc_floats((size_t)m->rows);
+    s.sum_x = calloc((size_t)m->rows, sizeof(double));
+    s.row_regret = alloc_floats((size_t)m->rows);
+    s.u = alloc_floats((size_t)m->rows);
+    s.y = alloc_floats((size_t)m->stride);
+    s.avg_y = alloc_floats((size_t)m->stride);
+    s.sum_y = calloc((size_t)m->stride, sizeof(double));
+    s.col_regret = alloc_floats((size_t)m->stride);
+    s.v = alloc_floats((size_t)m->stride);
+    s.workers = calloc((size_t)s.n_workers, sizeof(SolverWorker));
+    if (!s.x || !s.avg_x || !s.row_regret || !s.u || !s.y || !s.avg_y || !s.col_regret || !s.v || !s.workers
+        || !s.sum_x || !s.sum_y) {
+        rc = -1;
+        goto done;
+    }
+    for (int i = 0; i < m->rows; i++) s.x[i] = 1.0f / (float)m->rows;
+    for (int j = 0; j < m->cols; j++) s.y[j] = 1.0f / (float)m->cols;
+    partition(&s);
+
+    t0 = now_seconds();
+    if (s.n_workers == 1) {
+        solve_worker(&s.workers[0]);
+    } else {
+        pthread_barrier_init(&s.barrier, NULL, (unsigned)s.n_workers);
+        pthread_mutex_init(&s.start_lock, NULL);
+        pthread_cond_init(&s.start_cond, NULL);
+        for (started = 1; started < s.n_workers; started++)
+            if (pthread_create(&s.workers[started].thread, NULL, solve_thread, &s.workers[started]) != 0) break;
+        if (started == s.n_workers) {
+            set_start(&s, 1);
+            solve_worker(&s.workers[0]);
+        } else {
+            set_start(&s, -1);
+            rc = -1;
+        }
+        for (int w = 1; w < started; w++) pthread_join(s.workers[w].thread, NULL);
+        pthread_barrier_destroy(&s.barrier);
+        pthread_mutex_destroy(&s.start_lock);
+        pthread_cond_destroy(&s.start_cond);
+    }
+    result->seconds = now_seconds() - t0;
+    if (rc != 0) goto done;
+
+    result->row_strategy = s.avg_x;
+    result->col_strategy = s.avg_y;
+    s.avg_x = s.avg_y = NULL;
+    result->iterations = s.iterations;
+    result->exploitability = s.gap;
+    result->threads = s.n_workers;
+    row_values(m, result->col_strategy, 0, m->rows, s.u);
+    for (int i = 0; i < m->rows; i++) result->value += (double)result->row_strategy[i] * s.u[i];
+
+done:
+    free(s.x);
+    free(s.avg_x);
+    free(s.sum_x);
+    free(s.row_regret);
+    free(s.u);
+    free(s.y);
+    free(s.avg_y);
+    free(s.sum_y);
+    free(s.col_regret);
+    free(s.v);
+    free(s.workers);
+    return rc;
+}
+
+void solver_result_free(SolverResult *result) {
+    free(result->row_strategy);
+    free(result->col_strategy);
+    memset(result, 0, sizeof(*result));
+}
+
+/* --- Exploitability --- */
+double solver_best_row_value(const PayoffMatrix *m, const float *col_mix) {
+    float *values = alloc_floats((size_t)m->rows);
+    double best = -INFINITY;
+
+    if (!values) return NAN;
+    row_values(m, col_mix, 0, m->rows, values);
+    for (int i = 0; i < m->rows; i++) best = fmax(best, values[i]);
+    free(values);
+    return best;
+}
+
+double solver_best_col_value(const PayoffMatrix *m, const float *row_mix) {
+    float *values = alloc_floats((size_t)m->stride);
+    double best = INFINITY;
+
+    if (!values) return NAN;
+    col_values(m, row_mix, 0, m->stride, values);
+    for (int j = 0; j < m->cols; j++) best = fmin(best, values[j]);
+    free(values);
+    return best;
+}
+
+double solver_col_exploitability(const PayoffMatrix *m, const uint64_t *col_counts, double value) {
+    float *mix = alloc_floats((size_t)m->stride);
+    uint64_t n = 0;
+    double best;
+
+    if (!mix) return NAN;
+    for (int j = 0; j < m->cols; j++) n += col_counts[j];
+    for (int j = 0; j < m->cols; j++) mix[j] = n ? (float)((double)col_counts[j] / (double)n) : 1.0f / (float)m->cols;
+    best = solver_best_row_value(m, mix);
+    free(mix);
+    return best - value;
+}
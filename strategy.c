@@ -0,0 +1,152 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Built-in strategies
+ * ----------------------------------------------------------------------------
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "engine.h"
+#include "strategy.h"
+
+/* --- Random --- */
+static int random_choose(Strategy *self) {
+    RandomStrategy *s = (RandomStrategy *)self;
+    return (int)rng_bounded(&s->rng, s->n_moves) + 1; /* unbiased int in 1..N */
+}
+
+void random_strategy_init(RandomStrategy *s, uint64_t seed) {
+    s->base.name = "random";
+    s->base.choose = random_choose;
+    s->base.observe = NULL;
+    s->n_moves = (uint32_t)rules->n_moves;
+    rng_seed(&s->rng, seed);
+}
+
+/* --- Constant --- */
+static int constant_choose(Strategy *self) {
+    return ((ConstantStrategy *)self)->choice;
+}
+
+void constant_strategy_init(ConstantStrategy *s, int choice) {
+    s->base.name = "constant";
+    s->base.choose = constant_choose;
+    s->base.observe = NULL;
+    s->choice = choice;
+}
+
+/* --- Cycle --- */
+static int cycle_choose(Strategy *self) {
+    CycleStrategy *s = (CycleStrategy *)self;
+    int choice = s->next;
+    s->next = (choice == s->n_moves) ? 1 : choice + 1;
+    return choice;
+}
+
+void cycle_strategy_init(CycleStrategy *s) {
+    s->base.name = "cycle";
+    s->base.choose = cycle_choose;
+    s->base.observe = NULL;
+    s->next = 1;
+    s->n_moves = rules->n_moves;
+}
+
+/* --- Markov / frequency predictor --- */
+/* Predict the opponent's most frequent next move in this context and
+ * return the move that beats it. Ties (including an empty row) are broken
+ * with the RNG; once the table warms up they are rare, so the draw stays
+ * off the common path. */
+static int markov_choose(Strategy *self) {
+    MarkovStrategy *s = (MarkovStrategy *)self;
+    const uint8_t *row = s->counts[s->context];
+    int n_moves = s->n_moves;
+    int top = 0, n_tied = 0, best = 0;
+
+    /* two short passes of selects rather than a data-dependent branch per move */
+    for (int m = 0; m < n_moves; m++) top = (row[m] > top) ? row[m] : top;
+    for (int m = n_moves - 1; m >= 0; m--) {
+        int tied = (row[m] == top);
+        n_tied += tied;
+        best = tied ? m : best;
+    }
+    if (n_tied > 1) {
+        /* pick uniformly among the tied moves */
+        uint32_t k = rng_bounded(&s->rng, (uint32_t)n_tied);
+        for (best = 0; row[best] != top || k--; best++) {}
+    }
+    return s->counter[best + 1]; /* 0-based predicted move -> 1-based counter move */
+}
+
+static void markov_observe(Strategy *self, int own_move, int opponent_move) {
+    MarkovStrategy *s = (MarkovStrategy *)self;
+    uint8_t *row = s->counts[s->context];
+    int o = opponent_move - 1;
+    (void)own_move;
+
+    /* halve the row instead of overflowing; also lets old habits fade */
+    if (++row[o] == UINT8_MAX) {
+        for (int m = 0; m < RULES_MAX_MOVES; m++) row[m] >>= 1;
+    }
+
+    if (s->order == 2) s->context = (uint8_t)(s->last_move * s->n_moves + o);
+    else if (s->order == 1) s->context = (uint8_t)o;
+    s->last_move = (uint8_t)o;
+}
+
+void markov_strategy_init(MarkovStrategy *s, int order, uint64_t seed) {
+    memset(s, 0, sizeof(*s));
+    s->base.name = (order == 0) ? "frequency" : (order == 1) ? "markov1" : "markov";
+    s->base.choose = markov_choose;
+    s->base.observe = markov_observe;
+    s->counter = rules->counter;
+    s->n_moves = (uint8_t)rules->n_moves;
+    s->order = (uint8_t)((order < 0) ? 0 : (order > MARKOV_MAX_ORDER) ? MARKOV_MAX_ORDER : order);
+    rng_seed(&s->rng, seed);
+}
+
+/* --- Registry --- */
+const char *const strategy_names[] = {
+    "random", "rock", "paper", "scissors", "cycle", "frequency", "markov1", "markov"
+};
+const int strategy_count = (int)(sizeof(strategy_names) / sizeof(strategy_names[0]));
+
+Strategy *strategy_init(StrategyStorage *storage, const char *name, uint64_t seed) {
+    int move;
+
+    if (!name) return NULL;
+
+    if (strcmp(name, "random") == 0) {
+        random_strategy_init(&storage->random, seed);
+        return &storage->base;
+    }
+    if ((move = rules_move_by_label(rules, name)) != 0) {
+        ConstantStrategy *s = &storage->constant;
+        constant_strategy_init(s, move);
+        s->base.name = rules->labels[move];
+        for (int i = 0; i < strategy_count; i++)
+            if (strcmp(name, strategy_names[i]) == 0) s->base.name = strategy_names[i]; /* keep "rock" lower-case */
+        return &storage->base;
+    }
+    if (strcmp(name, "cycle") == 0) {
+        cycle_strategy_init(&storage->cycle);
+        return &storage->base;
+    }
+    if (strcmp(name, "frequency") == 0 || strcmp(name, "markov1") == 0 || strcmp(name, "markov") == 0) {
+        markov_strategy_init(&storage->markov, (name[0] == 'f') ? 0 : (strcmp(name, "markov1") == 0) ? 1 : 2, seed);
+        return &storage->base;
+    }
+    return NULL;
+}
+
+Strategy *strategy_new(const char *name, uint64_t seed) {
+    StrategyStorage *storage = malloc(sizeof(*storage));
+    Strategy *s = storage ? strategy_init(storage, name, seed) : NULL;
+
+    if (!s) free(storage);
+    return s;
+}
+
+void strategy_free(Strategy *strategy) {
+    free(strategy);
+}
@@ -0,0 +1,93 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Strategy interface (GTK-free)
+ * ----------------------------------------------------------------------------
+ * NOTE: A strategy picks a move for one side of a match. Concrete strategies
+ * embed Strategy as their first member so a Strategy* can be cast back.
+ */
+
+#ifndef RPS_STRATEGY_H
+#define RPS_STRATEGY_H
+
+#include <stdint.h>
+#include "rng.h"
+#include "rules.h"
+
+typedef struct Strategy Strategy;
+
+struct Strategy {
+    const char *name;
+    /* return the next move (1..n_moves of the active rule set) */
+    int (*choose)(Strategy *self);
+    /* optional: told both moves after each round, may be NULL */
+    void (*observe)(Strategy *self, int own_move, int opponent_move);
+};
+
+/* Uniform random move drawn from its own RNG stream */
+typedef struct {
+    Strategy base;
+    Rng rng;
+    uint32_t n_moves;
+} RandomStrategy;
+
+/* Always plays the same move, handy for regression runs */
+typedef struct {
+    Strategy base;
+    int choice;
+} ConstantStrategy;
+
+/* Plays every move in list order, then wraps (a predictable "human") */
+typedef struct {
+    Strategy base;
+    int next;
+    int n_moves;
+} CycleStrategy;
+
+/* Adaptive opponent: predicts the other side's next move from its last
+ * `order` moves (0 = plain frequency, 1..2 = Markov/n-gram) and plays the
+ * move that beats it. All counters fit in one small table (27 bytes used
+ * for the classic rules, 343 for RPS-7), so predict and update are O(1)
+ * and stay in L1 however long the session runs. */
+#define MARKOV_MAX_ORDER 2
+#define MARKOV_CONTEXTS (RULES_MAX_MOVES * RULES_MAX_MOVES) /* N^MARKOV_MAX_ORDER */
+
+typedef struct {
+    Strategy base;
+    Rng rng;                          /* tie-breaking */
+    const uint8_t *counter;           /* rules->counter of the rules it plays */
+    uint8_t n_moves;
+    uint8_t order;
+    uint8_t context;                  /* last `order` opponent moves, base N */
+    uint8_t last_move;                /* 0-based, the low digit of `context` */
+    uint8_t counts[MARKOV_CONTEXTS][RULES_MAX_MOVES]; /* next-move counts per context, halved on overflow */
+} MarkovStrategy;
+
+void random_strategy_init(RandomStrategy *s, uint64_t seed);
+void constant_strategy_init(ConstantStrategy *s, int choice);
+void cycle_strategy_init(CycleStrategy *s);
+void markov_strategy_init(MarkovStrategy *s, int order, uint64_t seed);
+
+/* --- Registry --- */
+/* Room for any built-in strategy, for callers that embed one */
+typedef union {
+    Strategy base;
+    RandomStrategy random;
+    ConstantStrategy constant;
+    CycleStrategy cycle;
+    MarkovStrategy markov;
+} StrategyStorage;
+
+/* Initialise a strategy in caller-owned storage; NULL if the name is unknown */
+Strategy *strategy_init(StrategyStorage *storage, const char *name, uint64_t seed);
+
+/* Heap-allocated strategy by name ("random", "rock", "paper", "scissors",
+ * "cycle", "frequency", "markov", "markov1"); NULL if the name is unknown.
+ * Strategies play the rule set that is active when they are created; a
+ * constant strategy may also name any move of it ("spock"). */
+Strategy *strategy_new(const char *name, uint64_t seed);
+void strategy_free(Strategy *strategy);
+extern const char *const strategy_names[];
+extern const int strategy_count;
+
+#endif /* RPS_STRATEGY_H */
@@ -0,0 +1,20 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Tool: bot-vs-bot matches streamed as JSON Lines or packed binary
+ * ----------------------------------------------------------------------------
+ * Build: gcc -O2 -std=gnu11 -I. tools/rps_bots.c bots.c outbuf.c engine.c strategy.c rules.c rng.c -o rps_bots
+ * Usage: rps_bots [-n matches] [-f jsonl|binary] [-g rounds|matches] [-o path] [-s seed] [-r rules] [-m format] [strategy_a [strategy_b]]
+ *
+ * Plays strategy_a (default markov) against strategy_b (default random)
+ * and writes one record per round (-g rounds, the default) or per match
+ * to stdout or -o path; the record formats are described in bots.h. A
+ * summary with the record rate goes to stderr. The GUI binary runs the
+ * same thing as `rps --bots ...`.
+ */
+
+#include "bots.h"
+
+int main(int argc, char **argv) {
+    return bots_main(argc, argv);
+}
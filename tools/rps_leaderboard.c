@@ -0,0 +1,138 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Tool: persistent leaderboard inspection and bulk loading
+ * ----------------------------------------------------------------------------
+ * Build: gcc -O2 -std=gnu11 -pthread -I. tools/rps_leaderboard.c leaderboard.c matchlog.c rules.c rng.c -o rps_leaderboard
+ * Usage: rps_leaderboard [-f path] top
+ *        rps_leaderboard [-f path] show NAME
+ *        rps_leaderboard [-f path] record NAME win|loss|draw
+ *        rps_leaderboard [-f path] fill PLAYERS MATCHES [seed]
+ *
+ * The file defaults to the one the game uses (see leaderboard_default_path()).
+ * fill records MATCHES random results for PLAYERS synthetic players
+ * ("player0000042") and reports the update rate and the rank lookup time.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "engine.h"
+#include "leaderboard.h"
+#include "rng.h"
+
+static void usage(const char *prog) {
+    fprintf(stderr, "usage: %s [-f path] top | show NAME | record NAME win|loss|draw | fill PLAYERS MATCHES [seed]\n",
+            prog);
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void print_standing(const LeaderboardStanding *s) {
+    printf("%s: %u wins, %u losses, %u draws, rank %llu of %llu\n", s->player.name, s->player.wins,
+           s->player.losses, s->player.draws, (unsigned long long)s->rank, (unsigned long long)s->players);
+}
+
+static void print_top(const LeaderboardStanding *s) {
+    printf("%4s  %-24s %8s %8s %8s\n", "rank", "player", "wins", "losses", "draws");
+    for (int i = 0; i < s->n_top; i++)
+        printf("%4d  %-24s %8u %8u %8u\n", i + 1, s->top[i].name, s->top[i].wins, s->top[i].losses,
+               s->top[i].draws);
+}
+
+static void fill(Leaderboard *lb, uint64_t players, uint64_t matches, uint64_t seed) {
+    char name[32];
+    Rng rng;
+    LeaderboardStanding standing;
+    double begin, seconds;
+    const int lookups = 100000;
+
+    rng_seed(&rng, seed);
+    begin = now_seconds();
+    for (uint64_t m = 0; m < matches; m++) {
+        snprintf(name, sizeof(name), "player%07llu", (unsigned long long)rng_bounded(&rng, (uint32_t)players));
+        leaderboard_submit(lb, name, (int)rng_bounded(&rng, 3), NULL, NULL);
+    }
+    leaderboard_sync(lb);
+    seconds = now_seconds() - begin;
+    printf("%llu results in %.2f s: %.0f updates/s, %llu players stored\n", (unsigned long long)matches, seconds,
+           matches / seconds, (unsigned long long)leaderboard_players(lb));
+
+    begin = now_seconds();
+    for (int i = 0; i < lookups; i++) {
+        snprintf(name, sizeof(name), "player%07llu", (unsigned long long)rng_bounded(&rng, (uint32_t)players));
+        leaderboard_lookup(lb, name, &standing);
+    }
+    printf("lookup with rank and top %d: %.0f ns\n", LEADERBOARD_TOP_K, (now_seconds() - begin) / lookups * 1e9);
+}
+
+int main(int argc, char **argv) {
+    char *path = NULL;
+    int arg = 1, status = 0;
+    Leaderboard *lb;
+    LeaderboardStanding standing;
+
+    if (argc > 2 && strcmp(argv[1], "-f") == 0) {
+        path = strdup(argv[2]);
+        arg = 3;
+    } else {
+        path = leaderboard_default_path();
+    }
+    if (arg >= argc || !path) {
+        usage(argv[0]);
+        free(path);
+        return 2;
+    }
+    if (!(lb = leaderboard_open(path))) {
+        perror(path);
+        free(path);
+        return 1;
+    }
+
+    if (strcmp(argv[arg], "top") == 0) {
+        leaderboard_lookup(lb, "", &standing);
+        printf("%llu players in %s\n", (unsigned long long)standing.players, path);
+        print_top(&standing);
+    } else if (strcmp(argv[arg], "show") == 0 && arg + 1 < argc) {
+        leaderboard_lookup(lb, argv[arg + 1], &standing);
+        print_standing(&standing);
+    } else if (strcmp(argv[arg], "record") == 0 && arg + 2 < argc) {
+        const char *what = argv[arg + 2];
+        int result = strcmp(what, "win") == 0 ? RESULT_PLAYER_WIN
+                   : strcmp(what, "loss") == 0 ? RESULT_COMPUTER_WIN
+                   : strcmp(what, "draw") == 0 ? RESULT_DRAW : -1;
+        if (result < 0) {
+            usage(argv[0]);
+            status = 2;
+        } else {
+            leaderboard_submit(lb, argv[arg + 1], result, NULL, NULL);
+            leaderboard_sync(lb);
+            leaderboard_lookup(lb, argv[arg + 1], &standing);
+            print_standing(&standing);
+        }
+    } else if (strcmp(argv[arg], "fill") == 0 && arg + 2 < argc) {
+        uint64_t players = strtoull(argv[arg + 1], NULL, 0), matches = strtoull(argv[arg + 2], NULL, 0);
+        uint64_t seed = (arg + 3 < argc) ? strtoull(argv[arg + 3], NULL, 0) : rng_seed_from_env("RPS_SEED");
+        if (players == 0 || players > UINT32_MAX) {
+            usage(argv[0]);
+            status = 2;
+        } else {
+            fill(lb, players, matches, seed);
+        }
+    } else {
+        usage(argv[0]);
+        status = 2;
+    }
+
+    if (leaderboard_close(lb) < 0) {
+        fprintf(stderr, "%s: write failed\n", path);
+        status = 1;
+    }
+    free(path);
+    return status;
+}
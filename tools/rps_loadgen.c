@@ -0,0 +1,213 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Tool: load generator for rps_server
+ * ----------------------------------------------------------------------------
+ * Build: gcc -O2 -std=gnu11 -pthread -I. tools/rps_loadgen.c server.c session.c pool.c histogram.c engine.c strategy.c rules.c rng.c outcome.c -o rps_loadgen
+ * Usage: rps_loadgen [-a address] [-c connections] [-m matches_per_connection] [-t threads] [-r rules]
+ *
+ * Every connection plays bot matches back to back. Round latency is the
+ * time from sending MOVE to receiving the ROUND reply; p50/p99 come from a
+ * per-thread histogram merged at the end.
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include "engine.h"
+#include "histogram.h"
+#include "rng.h"
+#include "rules.h"
+#include "server.h"
+
+typedef struct {
+    int fd;
+    MatchFormat format;         /* from START: the server decides when a match is over */
+    uint64_t matches_left;
+    uint64_t sent_ns;
+    size_t in_len;
+    char in[SERVER_LINE_MAX * 2];
+} Client;
+
+typedef struct {
+    const char *address;
+    int n_clients;
+    uint64_t matches;
+    Histogram latency;
+    uint64_t rounds;
+    uint64_t errors;
+    pthread_t thread;
+    int id;
+} Worker;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int send_all(int fd, const char *text) {
+    size_t len = strlen(text), off = 0;
+    while (off < len) {
+        ssize_t n = send(fd, text + off, len - off, MSG_NOSIGNAL);
+        if (n > 0) off += (size_t)n;
+        else if (n < 0 && (errno == EAGAIN || errno == EINTR)) continue; /* tiny writes: spin is fine */
+        else return -1;
+    }
+    return 0;
+}
+
+static int send_move(Client *c, Rng *rng) {
+    char line[24];
+    snprintf(line, sizeof(line), "MOVE %u\n", rng_bounded(rng, (uint32_t)rules->n_moves) + 1);
+    c->sent_ns = now_ns();
+    return send_all(c->fd, line);
+}
+
+/* Returns 1 when the client has finished all its matches, -1 on error */
+static int client_line(Worker *w, Client *c, Rng *rng, const char *line) {
+    if (strncmp(line, "START ", 6) == 0) {
+        char format[64], rules_name[16];
+        if (sscanf(line, "START %*s %63s %15s", format, rules_name) != 2 || strcmp(rules_name, rules->name) != 0 ||
+            !match_format_parse(format, &c->format))
+            return -1;
+        return send_move(c, rng) < 0 ? -1 : 0;
+    }
+    if (strncmp(line, "ROUND ", 6) == 0) {
+        int round, you, them, result, your_score, their_score;
+
+        hist_record(&w->latency, now_ns() - c->sent_ns);
+        w->rounds++;
+        if (sscanf(line + 6, "%d %d %d %d %d %d", &round, &you, &them, &result, &your_score, &their_score) != 6)
+            return -1;
+        if (!match_format_decided(&c->format, your_score, their_score, round)) return send_move(c, rng) < 0 ? -1 : 0;
+        return 0; /* MATCH follows */
+    }
+    if (strncmp(line, "MATCH ", 6) == 0) {
+        if (--c->matches_left == 0) return 1;
+        return send_all(c->fd, "PLAY BOT\n") < 0 ? -1 : 0;
+    }
+    if (strncmp(line, "ERR", 3) == 0) return -1;
+    return 0; /* WELCOME */
+}
+
+static void *worker_main(void *arg) {
+    Worker *w = arg;
+    Client *clients = calloc((size_t)w->n_clients, sizeof(Client));
+    struct epoll_event events[256];
+    int epfd = epoll_create1(EPOLL_CLOEXEC), live = 0;
+    Rng rng;
+
+    rng_seed(&rng, (uint64_t)w->id + 1);
+    hist_init(&w->latency);
+
+    for (int i = 0; i < w->n_clients; i++) {
+        Client *c = &clients[i];
+        char hello[64];
+        c->fd = server_connect_socket(w->address);
+        if (c->fd < 0) { w->errors++; continue; }
+        c->matches_left = w->matches;
+        fcntl(c->fd, F_SETFL, fcntl(c->fd, F_GETFL, 0) | O_NONBLOCK);
+        snprintf(hello, sizeof(hello), "HELLO lg%d_%d\nPLAY BOT\n", w->id, i);
+        if (send_all(c->fd, hello) < 0) { close(c->fd); c->fd = -1; w->errors++; continue; }
+        struct epoll_event ev = { .events = EPOLLIN, .data.ptr = c };
+        epoll_ctl(epfd, EPOLL_CTL_ADD, c->fd, &ev);
+        live++;
+    }
+
+    while (live > 0) {
+        int n = epoll_wait(epfd, events, 256, 5000);
+        if (n == 0) { fprintf(stderr, "loadgen: stalled with %d live clients\n", live); break; }
+        for (int i = 0; i < n; i++) {
+            Client *c = events[i].data.ptr;
+            ssize_t got = recv(c->fd, c->in + c->in_len, sizeof(c->in) - c->in_len, 0);
+            int done = 0;
+            if (got <= 0) {
+                if (got < 0 && errno == EAGAIN) continue;
+                done = -1;
+            } else {
+                char *start = c->in, *end = c->in + c->in_len + got, *nl;
+                c->in_len += (size_t)got;
+                while (!done && (nl = memchr(start, '\n', (size_t)(end - start))) != NULL) {
+                    *nl = '\0';
+                    done = client_line(w, c, &rng, start);
+                    start = nl + 1;
+                }
+                c->in_len = (size_t)(end - start);
+                memmove(c->in, start, c->in_len);
+            }
+            if (done) {
+                if (done < 0) w->errors++;
+                else send_all(c->fd, "QUIT\n");
+                epoll_ctl(epfd, EPOLL_CTL_DEL, c->fd, NULL);
+                close(c->fd);
+                c->fd = -1;
+                live--;
+            }
+        }
+    }
+
+    close(epfd);
+    free(clients);
+    return NULL;
+}
+
+int main(int argc, char **argv) {
+    const char *address = "127.0.0.1:7777";
+    int connections = 1000, threads = 1;
+    uint64_t matches = 100;
+    struct rlimit rl;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-a") == 0 && i + 1 < argc) address = argv[++i];
+        else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) connections = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) matches = strtoull(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc && rules_select(argv[i + 1])) i++;
+        else {
+            fprintf(stderr, "usage: %s [-a address] [-c connections] [-m matches_per_connection] [-t threads] [-r classic|rpsls|rps7]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (threads < 1) threads = 1;
+    if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur < rl.rlim_max) {
+        rl.rlim_cur = rl.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &rl);
+    }
+
+    Worker *workers = calloc((size_t)threads, sizeof(Worker));
+    uint64_t t0 = now_ns();
+    for (int t = 0; t < threads; t++) {
+        workers[t].id = t;
+        workers[t].address = address;
+        workers[t].matches = matches;
+        workers[t].n_clients = connections / threads + (t < connections % threads);
+        pthread_create(&workers[t].thread, NULL, worker_main, &workers[t]);
+    }
+
+    Histogram total;
+    uint64_t rounds = 0, errors = 0;
+    hist_init(&total);
+    for (int t = 0; t < threads; t++) {
+        pthread_join(workers[t].thread, NULL);
+        hist_merge(&total, &workers[t].latency);
+        rounds += workers[t].rounds;
+        errors += workers[t].errors;
+    }
+    double seconds = (double)(now_ns() - t0) / 1e9;
+
+    printf("%d connections, %llu rounds in %.2f s (%.0f rounds/s), %llu errors\n", connections,
+           (unsigned long long)rounds, seconds, (double)rounds / seconds, (unsigned long long)errors);
+    hist_print(&total, "round latency", "us", 1000.0, stdout);
+    free(workers);
+    return errors ? 1 : 0;
+}
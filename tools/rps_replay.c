@@ -0,0 +1,153 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Tool: replay / re-score a binary match log
+ * ----------------------------------------------------------------------------
+ * Build: gcc -O2 -std=gnu11 -pthread -I. tools/rps_replay.c matchlog.c engine.c strategy.c rules.c rng.c outcome.c -o rps_replay
+ * Usage: rps_replay [-r] log            re-score every round, -r cuts a damaged tail off first
+ *        rps_replay -g rounds [-s seed] [-f format] log   append synthetic matches (markov vs random)
+ *
+ * Re-scoring recomputes each outcome from the two moves and reports any
+ * record whose stored outcome differs. Classic logs go through the batch
+ * kernel in outcome.h; logs of other variants (the header says which) use
+ * that variant's outcome table. -g writes under RPS_RULES (default classic),
+ * in the match format of -f or RPS_FORMAT: each match ends when decided, so
+ * match lengths vary as in a log the GUI wrote.
+ * The GUI writes a log when started with RPS_MATCH_LOG=<path>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "engine.h"
+#include "matchlog.h"
+#include "outcome.h"
+#include "rng.h"
+#include "rules.h"
+
+static double seconds_between(uint64_t t0, uint64_t t1) {
+    return (double)(t1 - t0) / 1e9;
+}
+
+static int generate(const char *path, uint64_t rounds, uint64_t seed) {
+    MatchLogWriter *w = matchlog_writer_open(path);
+    Strategy *a = strategy_new("markov", rng_derive_seed(seed, 0));
+    Strategy *b = strategy_new("random", rng_derive_seed(seed, 1));
+    MatchLogRecord rec;
+    uint64_t t0, t1;
+    int rc, round = 0, score_a = 0, score_b = 0;
+
+    if (!w || !a || !b) {
+        perror(path);
+        return 1;
+    }
+    memset(&rec, 0, sizeof(rec));
+    rec.session = (uint32_t)rng_derive_seed(seed, 2);
+    t0 = matchlog_now_ns();
+    for (uint64_t i = 0; i < rounds; i++) {
+        int pa = a->choose(a), pb = b->choose(b);
+        a->observe(a, pa, pb);
+        if (b->observe) b->observe(b, pb, pa);
+
+        if (round == 0) rec.session++;
+        rec.timestamp_ns = t0 + i * 1000; /* synthetic: one round per microsecond */
+        rec.round = (uint8_t)++round;
+        rec.player_move = (uint8_t)pa;
+        rec.opponent_move = (uint8_t)pb;
+        rec.outcome = (uint8_t)decide_round(pa, pb);
+        matchlog_append_wait(w, &rec);
+
+        score_a += (rec.outcome == RESULT_PLAYER_WIN);
+        score_b += (rec.outcome == RESULT_COMPUTER_WIN);
+        if (match_format_decided(&match_format, score_a, score_b, round)) round = score_a = score_b = 0;
+    }
+    rc = matchlog_writer_close(w);
+    t1 = matchlog_now_ns();
+    printf("wrote %llu rounds in %.2f s (%.1f M rounds/s)\n", (unsigned long long)rounds,
+           seconds_between(t0, t1), (double)rounds / seconds_between(t0, t1) / 1e6);
+    strategy_free(a);
+    strategy_free(b);
+    return rc == 0 ? 0 : 1;
+}
+
+static int replay(const char *path, int recover) {
+    uint8_t packed[MATCHLOG_BLOCK_RECORDS], outcomes[MATCHLOG_BLOCK_RECORDS];
+    uint64_t tally[3] = { 0, 0, 0 }, mismatches = 0, matches = 0, t0, t1;
+    const MatchLogRecord *records;
+    const RuleSet *log_rules;
+    MatchLogReader r;
+    size_t offset = 0;
+    uint32_t count;
+
+    if (recover) {
+        long long removed = matchlog_recover(path);
+        if (removed < 0) {
+            perror(path);
+            return 1;
+        }
+        if (removed > 0) printf("recovered: cut %lld damaged bytes\n", removed);
+    }
+
+    t0 = matchlog_now_ns();
+    if (matchlog_reader_open(&r, path) < 0) {
+        perror(path);
+        return 1;
+    }
+    log_rules = rules_by_id(r.rules);
+    while (matchlog_next_block(&r, &offset, &records, &count)) {
+        if (log_rules->id == RULES_ID_CLASSIC) {
+            for (uint32_t i = 0; i < count; i++) {
+                packed[i] = pack_moves(records[i].player_move, records[i].opponent_move);
+                matches += (records[i].round == 1);
+            }
+            resolve_rounds(packed, count, outcomes, NULL);
+        } else {
+            for (uint32_t i = 0; i < count; i++) {
+                outcomes[i] = (uint8_t)rules_outcome(log_rules, records[i].player_move, records[i].opponent_move);
+                matches += (records[i].round == 1);
+            }
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            tally[outcomes[i] % 3]++;
+            mismatches += (outcomes[i] != records[i].outcome);
+        }
+    }
+    t1 = matchlog_now_ns();
+
+    printf("%s: %s rules, %llu rounds in %llu blocks, %llu matches%s\n", path, log_rules->name,
+           (unsigned long long)r.records, (unsigned long long)r.blocks, (unsigned long long)matches,
+           r.truncated ? " (damaged tail ignored; -r to cut it)" : "");
+    if (r.records) {
+        printf("player: %.2f%% won, %.2f%% drawn, %.2f%% lost\n", 100.0 * tally[RESULT_PLAYER_WIN] / r.records,
+               100.0 * tally[RESULT_DRAW] / r.records, 100.0 * tally[RESULT_COMPUTER_WIN] / r.records);
+    }
+    printf("re-scored in %.3f s (%.1f M rounds/s, %.2f GB/s, %s kernel), %llu mismatches\n",
+           seconds_between(t0, t1), (double)r.records / seconds_between(t0, t1) / 1e6,
+           (double)r.valid_end / seconds_between(t0, t1) / 1e9,
+           log_rules->id == RULES_ID_CLASSIC ? outcome_kernel_name() : "table",
+           (unsigned long long)mismatches);
+    matchlog_reader_close(&r);
+    return mismatches ? 1 : 0;
+}
+
+int main(int argc, char **argv) {
+    uint64_t rounds = 0, seed = rng_seed_from_env("RPS_SEED");
+    const char *path = NULL;
+    int recover = 0, bad = 0;
+
+    if (!match_format_select_from_env()) fprintf(stderr, "RPS_FORMAT: not a format, playing best-of-%d\n", TOTAL_ROUNDS);
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-g") == 0 && i + 1 < argc) rounds = strtoull(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) seed = strtoull(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc && match_format_parse(argv[i + 1], &match_format)) i++;
+        else if (strcmp(argv[i], "-r") == 0) recover = 1;
+        else if (argv[i][0] != '-' && !path) path = argv[i];
+        else bad = 1;
+    }
+    if (!rules_select_from_env()) bad = 1;
+    if (bad || !path) {
+        fprintf(stderr, "usage: %s [-r] log | -g rounds [-s seed] [-f format] log\n", argv[0]);
+        return 2;
+    }
+    return rounds ? generate(path, rounds, seed) : replay(path, recover);
+}
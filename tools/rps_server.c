@@ -0,0 +1,43 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Tool: headless match server
+ * ----------------------------------------------------------------------------
+ * Build: gcc -O2 -std=gnu11 -pthread -I. tools/rps_server.c server.c session.c pool.c engine.c strategy.c rules.c rng.c outcome.c -o rps_server
+ * Usage: rps_server [-a address] [-l loops] [-b bot_strategy] [-s seed] [-r rules] [-f format]
+ *
+ * address is "host:port", ":port" (default :7777) or "unix:/path/to/socket".
+ * The GUI plays against this server when started with RPS_SERVER=<address>;
+ * both must run the same rules (-r here, RPS_RULES for either); the GUI
+ * takes the match format from the server.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "engine.h"
+#include "rng.h"
+#include "rules.h"
+#include "server.h"
+
+int main(int argc, char **argv) {
+    ServerConfig config = { ":7777", 0, "markov", 0 };
+
+    config.seed = rng_seed_from_env("RPS_SEED");
+    if (!rules_select_from_env()) fprintf(stderr, "RPS_RULES: unknown rules, using %s\n", rules->name);
+    if (!match_format_select_from_env()) fprintf(stderr, "RPS_FORMAT: not a format, playing best-of-%d\n", TOTAL_ROUNDS);
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-a") == 0 && i + 1 < argc) config.address = argv[++i];
+        else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) config.loops = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) config.bot_strategy = argv[++i];
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) config.seed = strtoull(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc && rules_select(argv[i + 1])) i++;
+        else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc && match_format_parse(argv[i + 1], &match_format)) i++;
+        else {
+            fprintf(stderr, "usage: %s [-a address] [-l loops] [-b bot_strategy] [-s seed] [-r classic|rpsls|rps7]"
+                            " [-f best-of-N|first-to-K[,no-draws][,max=R]]\n", argv[0]);
+            return 2;
+        }
+    }
+    return server_run(&config) == 0 ? 0 : 1;
+}
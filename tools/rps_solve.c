@@ -0,0 +1,160 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Tool: equilibrium solver + strategy exploitability report
+ * ----------------------------------------------------------------------------
+ * Build: gcc -O2 -std=gnu11 -pthread -I. tools/rps_solve.c solver.c engine.c strategy.c rules.c rng.c -lm -o rps_solve
+ * Usage: rps_solve [-r rules] [-w weights] [-e epsilon] [-i max_iterations] [-t threads] [-x rounds] [-s seed]
+ *        rps_solve --random N [-e epsilon] [-i max_iterations] [-t threads] [-s seed]
+ *
+ * Solves the rule set's payoff matrix (-w 2,1,1: a win with rock is worth
+ * 2, other wins 1) and prints the equilibrium mixes. Then every registered
+ * strategy plays the computer's side for -x rounds (default 1M) and gets
+ * two exploitability figures, in payoff units per round over the game value:
+ *   mix   what a player best-responding to its observed move frequencies
+ *         would win (0 for a strategy that plays the equilibrium mix)
+ *   pool  what the best registered strategy actually won against it
+ * --random N solves an N x N random game instead (threads pay off there).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "engine.h"
+#include "rng.h"
+#include "rules.h"
+#include "solver.h"
+
+static void usage(const char *prog) {
+    fprintf(stderr, "usage: %s [-r classic|rpsls|rps7] [-w weights] [-e epsilon] [-i max_iterations] [-t threads]"
+                    " [-x rounds] [-s seed]\n"
+                    "       %s --random N [-e epsilon] [-i max_iterations] [-t threads] [-s seed]\n", prog, prog);
+}
+
+/* "2,1,1" -> one weight per move; returns 0 if the count is wrong */
+static int parse_weights(const char *text, float *weights, int n_moves) {
+    int n = 0;
+    char *end;
+
+    while (*text && n < n_moves) {
+        weights[n++] = strtof(text, &end);
+        if (end == text) return 0;
+        text = (*end == ',') ? end + 1 : end;
+    }
+    return n == n_moves && *text == '\0';
+}
+
+/* Average row payoff of `player` against `computer` over `rounds` rounds;
+ * also counts the computer's moves */
+static double play(const PayoffMatrix *m, Strategy *player, Strategy *computer, uint64_t rounds, uint64_t *counts) {
+    double total = 0.0;
+
+    for (uint64_t r = 0; r < rounds; r++) {
+        int p = player->choose(player), c = computer->choose(computer);
+        total += payoff_at(m, p - 1, c - 1);
+        if (counts) counts[c - 1]++;
+        if (player->observe) player->observe(player, p, c);
+        if (computer->observe) computer->observe(computer, c, p);
+    }
+    return total / (double)rounds;
+}
+
+static void report_strategies(const PayoffMatrix *m, double value, uint64_t rounds, uint64_t seed) {
+    printf("\n%-10s %10s %10s  %s\n", "computer", "mix", "pool", "best responder");
+    for (int k = 0; k < strategy_count; k++) {
+        uint64_t counts[RULES_MAX_MOVES] = { 0 };
+        Strategy *s = strategy_new(strategy_names[k], rng_derive_seed(seed, (uint64_t)k));
+        Strategy *probe = strategy_new("random", rng_derive_seed(seed, 1000 + (uint64_t)k));
+        double best = -1e300;
+        const char *best_name = "-";
+
+        if (!s || !probe) {
+            fprintf(stderr, "%s: not available for %s rules\n", strategy_names[k], rules->name);
+            strategy_free(s);
+            strategy_free(probe);
+            continue;
+        }
+        /* its move frequencies against an opponent that gives nothing away */
+        play(m, probe, s, rounds, counts);
+        strategy_free(s);
+        strategy_free(probe);
+
+        for (int b = 0; b < strategy_count; b++) {
+            Strategy *player = strategy_new(strategy_names[b], rng_derive_seed(seed, 2000 + (uint64_t)b));
+            Strategy *computer = strategy_new(strategy_names[k], rng_derive_seed(seed, (uint64_t)k));
+            if (player && computer) {
+                double gain = play(m, player, computer, rounds, NULL);
+                if (gain > best) {
+                    best = gain;
+                    best_name = strategy_names[b];
+                }
+            }
+            strategy_free(player);
+            strategy_free(computer);
+        }
+        printf("%-10s %10.4f %10.4f  %s\n", strategy_names[k], solver_col_exploitability(m, counts, value),
+               best - value, best_name);
+    }
+}
+
+int main(int argc, char **argv) {
+    SolverConfig config = { 1e-4, 0, 1, 0 };
+    SolverResult result;
+    PayoffMatrix m;
+    float weights[RULES_MAX_MOVES];
+    const char *weight_text = NULL;
+    uint64_t rounds = 1000000, seed = rng_seed_from_env("RPS_SEED");
+    int random_moves = 0;
+
+    if (!rules_select_from_env()) {
+        usage(argv[0]);
+        return 2;
+    }
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-r") == 0 && i + 1 < argc && rules_select(argv[i + 1])) i++;
+        else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) weight_text = argv[++i];
+        else if (strcmp(argv[i], "-e") == 0 && i + 1 < argc) config.epsilon = strtod(argv[++i], NULL);
+        else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) config.max_iterations = strtoull(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) config.threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-x") == 0 && i + 1 < argc) rounds = strtoull(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) seed = strtoull(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "--random") == 0 && i + 1 < argc) random_moves = atoi(argv[++i]);
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (weight_text && !parse_weights(weight_text, weights, rules->n_moves)) {
+        fprintf(stderr, "-w needs %d comma-separated weights for %s\n", rules->n_moves, rules->name);
+        return 2;
+    }
+
+    if (random_moves > 0 ? payoff_random(&m, random_moves, random_moves, seed) < 0
+                         : payoff_from_rules(&m, rules, weight_text ? weights : NULL) < 0) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    if (solver_run(&m, &config, &result) < 0) {
+        fprintf(stderr, "solver failed\n");
+        payoff_free(&m);
+        return 1;
+    }
+
+    if (random_moves > 0) {
+        printf("random %dx%d game\n", m.rows, m.cols);
+    } else {
+        printf("%s rules%s%s\n%-10s %10s %10s\n", rules->name, weight_text ? ", win weights " : "",
+               weight_text ? weight_text : "", "move", "player", "computer");
+        for (int i = 0; i < m.rows; i++)
+            printf("%-10s %9.2f%% %9.2f%%\n", rules->labels[i + 1], 100.0 * result.row_strategy[i],
+                   100.0 * result.col_strategy[i]);
+    }
+    printf("value %.6f, exploitability %.2g after %llu iterations in %.3f ms on %d thread%s\n", result.value,
+           result.exploitability, (unsigned long long)result.iterations, result.seconds * 1e3, result.threads,
+           result.threads == 1 ? "" : "s");
+
+    if (random_moves == 0 && rounds > 0) report_strategies(&m, result.value, rounds, seed);
+    solver_result_free(&result);
+    payoff_free(&m);
+    return 0;
+}
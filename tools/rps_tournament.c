@@ -0,0 +1,86 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Tool: bot round-robin tournament
+ * ----------------------------------------------------------------------------
+ * Build: gcc -O2 -std=gnu11 -pthread -I. tools/rps_tournament.c tournament.c engine.c strategy.c rules.c rng.c outcome.c -o rps_tournament
+ * Usage: rps_tournament [-m matches_per_pair] [-t threads] [-s seed] [-c chunk] [-r rules] [-f format] [--scaling] [strategy...]
+ *
+ * With no strategies listed every registered strategy takes part. -r (or
+ * RPS_RULES) plays a variant from rules.h instead of the classic game.
+ * --scaling reruns the tournament on 1..threads workers and prints the
+ * speedup, to check the pool scales with cores.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "engine.h"
+#include "rules.h"
+#include "tournament.h"
+
+static void usage(const char *prog) {
+    fprintf(stderr, "usage: %s [-m matches_per_pair] [-t threads] [-s seed] [-c chunk] [-r classic|rpsls|rps7]"
+                    " [-f best-of-N|first-to-K[,no-draws][,max=R]] [--scaling] [strategy...]\n", prog);
+    fprintf(stderr, "strategies:");
+    for (int i = 0; i < strategy_count; i++) fprintf(stderr, " %s", strategy_names[i]);
+    fprintf(stderr, "\n");
+}
+
+int main(int argc, char **argv) {
+    TournamentConfig config = { strategy_names, strategy_count, 1000000, 0, 0, 1 };
+    const char **picked = calloc((size_t)argc, sizeof(char *));
+    int n_picked = 0, scaling = 0;
+    TournamentResult result;
+
+    if (!rules_select_from_env() || !match_format_select_from_env()) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) config.matches_per_pair = strtoull(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) config.threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) config.seed = strtoull(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) config.chunk_matches = strtoull(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc && rules_select(argv[i + 1])) i++;
+        else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc && match_format_parse(argv[i + 1], &match_format)) i++;
+        else if (strcmp(argv[i], "--scaling") == 0) scaling = 1;
+        else if (argv[i][0] == '-') { usage(argv[0]); return 2; }
+        else picked[n_picked++] = argv[i];
+    }
+    if (n_picked > 0) {
+        config.names = picked;
+        config.n_strategies = n_picked;
+    }
+
+    if (scaling) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        int max_threads = config.threads > 0 ? config.threads : (cores > 0 ? (int)cores : 1);
+        double base_rate = 0.0;
+
+        printf("%8s %14s %10s %11s\n", "threads", "matches/s", "speedup", "efficiency");
+        for (int t = 1; t <= max_threads; t *= 2) {
+            config.threads = t;
+            if (tournament_run(&config, &result) != 0) { usage(argv[0]); return 1; }
+            double rate = (double)result.matches / result.seconds;
+            if (t == 1) base_rate = rate;
+            printf("%8d %14.0f %9.2fx %10.0f%%\n", t, rate, rate / base_rate, 100.0 * rate / base_rate / t);
+            tournament_result_free(&result);
+            if (t < max_threads && t * 2 > max_threads) t = max_threads / 2; /* always finish on max_threads */
+        }
+        free(picked);
+        return 0;
+    }
+
+    if (tournament_run(&config, &result) != 0) {
+        usage(argv[0]);
+        free(picked);
+        return 1;
+    }
+    tournament_print(&result, config.names, stdout);
+    tournament_result_free(&result);
+    free(picked);
+    return 0;
+}
@@ -0,0 +1,274 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Parallel round-robin tournament
+ * ----------------------------------------------------------------------------
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "rng.h"
+#include "tournament.h"
+
+#define DEFAULT_CHUNK_MATCHES 65536
+
+/* One unit of work: `count` matches of one pairing */
+typedef struct {
+    int pair;                   /* index into the i < j pair list */
+    int a, b;                   /* strategy indices */
+    uint64_t count;
+    uint64_t seed;
+} Task;
+
+/* Per-worker deque. The owner pops from the bottom, thieves take from the
+ * top. Work items are large, so a plain mutex per deque costs nothing
+ * measurable and keeps the code obviously correct. */
+typedef struct {
+    pthread_mutex_t lock;
+    Task *tasks;
+    size_t top, bottom;         /* live range [top, bottom) */
+    size_t capacity;
+} TaskDeque;
+
+typedef struct TournamentPool TournamentPool;
+
+typedef struct {
+    TournamentPool *pool;
+    int id;
+    TaskDeque deque;
+    MatchStats *stats;          /* private per-pair totals, merged at the end */
+    uint64_t steals;
+    int failed;
+    pthread_t thread;
+} Worker;
+
+struct TournamentPool {
+    const TournamentConfig *config;
+    Worker *workers;
+    int n_workers;
+    int n_pairs;
+};
+
+/* --- Deque --- */
+static int deque_pop_bottom(TaskDeque *d, Task *out) {
+    int ok = 0;
+    pthread_mutex_lock(&d->lock);
+    if (d->bottom > d->top) {
+        *out = d->tasks[--d->bottom];
+        ok = 1;
+    }
+    pthread_mutex_unlock(&d->lock);
+    return ok;
+}
+
+static int deque_steal_top(TaskDeque *d, Task *out) {
+    int ok = 0;
+    pthread_mutex_lock(&d->lock);
+    if (d->bottom > d->top) {
+        *out = d->tasks[d->top++];
+        ok = 1;
+    }
+    pthread_mutex_unlock(&d->lock);
+    return ok;
+}
+
+/* --- Workers --- */
+static int next_task(Worker *w, Rng *victim_rng, Task *out) {
+    TournamentPool *pool = w->pool;
+
+    if (deque_pop_bottom(&w->deque, out)) return 1;
+
+    /* own deque empty: sweep the others starting at a random victim */
+    int start = (int)rng_bounded(victim_rng, (uint32_t)pool->n_workers);
+    for (int k = 0; k < pool->n_workers; k++) {
+        Worker *victim = &pool->workers[(start + k) % pool->n_workers];
+        if (victim != w && deque_steal_top(&victim->deque, out)) {
+            w->steals++;
+            return 1;
+        }
+    }
+    return 0; /* nothing left anywhere; no task creates new tasks, so we are done */
+}
+
+static void *worker_main(void *arg) {
+    Worker *w = arg;
+    const TournamentConfig *config = w->pool->config;
+    Rng victim_rng;
+    Task task;
+
+    rng_seed(&victim_rng, rng_derive_seed(config->seed, 0x57ea1ULL + (uint64_t)w->id));
+
+    while (next_task(w, &victim_rng, &task)) {
+        Strategy *a = strategy_new(config->names[task.a], rng_derive_seed(task.seed, 0));
+        Strategy *b = strategy_new(config->names[task.b], rng_derive_seed(task.seed, 1));
+        MatchStats chunk;
+
+        if (!a || !b) {
+            w->failed = 1;
+            strategy_free(a);
+            strategy_free(b);
+            continue;
+        }
+        simulate_matches(task.count, a, b, &chunk);
+        match_stats_merge(&w->stats[task.pair], &chunk);
+        strategy_free(a);
+        strategy_free(b);
+    }
+    return NULL;
+}
+
+static int online_cores(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (int)n : 1;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/* --- Public API --- */
+int tournament_run(const TournamentConfig *config, TournamentResult *result) {
+    int n = config->n_strategies;
+    int n_pairs = n * (n - 1) / 2;
+    uint64_t chunk = config->chunk_matches ? config->chunk_matches : DEFAULT_CHUNK_MATCHES;
+    uint64_t chunks_per_pair = (config->matches_per_pair + chunk - 1) / chunk;
+    size_t n_tasks = (size_t)n_pairs * chunks_per_pair;
+    TournamentPool pool;
+    int rc = 0;
+
+    memset(result, 0, sizeof(*result));
+    if (n < 2 || config->matches_per_pair == 0) return -1;
+    for (int i = 0; i < n; i++) {
+        Strategy *probe = strategy_new(config->names[i], 0);
+        if (!probe) return -1;
+        strategy_free(probe);
+    }
+
+    pool.config = config;
+    pool.n_pairs = n_pairs;
+    pool.n_workers = config->threads > 0 ? config->threads : online_cores();
+    pool.workers = calloc((size_t)pool.n_workers, sizeof(Worker));
+    if (!pool.workers) return -1;
+
+    for (int w = 0; w < pool.n_workers; w++) {
+        Worker *worker = &pool.workers[w];
+        worker->pool = &pool;
+        worker->id = w;
+        worker->stats = calloc((size_t)n_pairs, sizeof(MatchStats));
+        worker->deque.capacity = n_tasks / (size_t)pool.n_workers + 1;
+        worker->deque.tasks = malloc(worker->deque.capacity * sizeof(Task));
+        pthread_mutex_init(&worker->deque.lock, NULL);
+        if (!worker->stats || !worker->deque.tasks) rc = -1;
+    }
+
+    /* deal chunks round-robin so every worker starts with a similar mix */
+    if (rc == 0) {
+        size_t t = 0;
+        for (int i = 0, pair = 0; i < n; i++) {
+            for (int j = i + 1; j < n; j++, pair++) {
+                uint64_t left = config->matches_per_pair;
+                for (uint64_t c = 0; c < chunks_per_pair; c++, t++) {
+                    TaskDeque *d = &pool.workers[t % (size_t)pool.n_workers].deque;
+                    Task *task = &d->tasks[d->bottom++];
+                    task->pair = pair;
+                    task->a = i;
+                    task->b = j;
+                    task->count = left < chunk ? left : chunk;
+                    task->seed = rng_derive_seed(config->seed, t);
+                    left -= task->count;
+                }
+            }
+        }
+    }
+
+    double t0 = now_seconds();
+    int started = 0;
+    if (rc == 0) {
+        for (; started < pool.n_workers; started++) {
+            if (pthread_create(&pool.workers[started].thread, NULL, worker_main, &pool.workers[started]) != 0) {
+                rc = -1;
+                break;
+            }
+        }
+        for (int w = 0; w < started; w++) pthread_join(pool.workers[w].thread, NULL);
+    }
+    double t1 = now_seconds();
+
+    /* merge per-worker totals */
+    if (rc == 0) {
+        result->pairs = calloc((size_t)n * (size_t)n, sizeof(MatchStats));
+        if (!result->pairs) rc = -1;
+    }
+    if (rc == 0) {
+        result->n_strategies = n;
+        result->threads = pool.n_workers;
+        result->seconds = t1 - t0;
+        for (int w = 0; w < pool.n_workers; w++) {
+            Worker *worker = &pool.workers[w];
+            if (worker->failed) rc = -1;
+            result->steals += worker->steals;
+            for (int i = 0, pair = 0; i < n; i++) {
+                for (int j = i + 1; j < n; j++, pair++) {
+                    match_stats_merge(&result->pairs[i * n + j], &worker->stats[pair]);
+                    result->matches += worker->stats[pair].matches;
+                }
+            }
+        }
+    }
+
+    for (int w = 0; w < pool.n_workers; w++) {
+        pthread_mutex_destroy(&pool.workers[w].deque.lock);
+        free(pool.workers[w].deque.tasks);
+        free(pool.workers[w].stats);
+    }
+    free(pool.workers);
+    if (rc != 0) tournament_result_free(result);
+    return rc;
+}
+
+/* Win/draw/loss matrix from the row strategy's point of view, then throughput */
+void tournament_print(const TournamentResult *result, const char *const *names, FILE *out) {
+    int n = result->n_strategies;
+
+    fprintf(out, "%-10s", "W/D/L %");
+    for (int j = 0; j < n; j++) fprintf(out, " %17s", names[j]);
+    fprintf(out, "\n");
+
+    for (int i = 0; i < n; i++) {
+        fprintf(out, "%-10s", names[i]);
+        for (int j = 0; j < n; j++) {
+            const MatchStats *st;
+            double w, d, l;
+
+            if (i == j) {
+                fprintf(out, " %17s", "-");
+                continue;
+            }
+            st = (i < j) ? &result->pairs[i * n + j] : &result->pairs[j * n + i];
+            if (st->matches == 0) {
+                fprintf(out, " %17s", "n/a");
+                continue;
+            }
+            w = 100.0 * (double)((i < j) ? st->a_wins : st->b_wins) / (double)st->matches;
+            l = 100.0 * (double)((i < j) ? st->b_wins : st->a_wins) / (double)st->matches;
+            d = 100.0 * (double)st->draws / (double)st->matches;
+            fprintf(out, "  %5.1f/%4.1f/%5.1f", w, d, l);
+        }
+        fprintf(out, "\n");
+    }
+
+    double rate = result->seconds > 0 ? (double)result->matches / result->seconds : 0.0;
+    fprintf(out, "\n%llu matches in %.3f s on %d threads: %.2f M matches/s, %.2f M matches/s/core (%llu steals)\n",
+            (unsigned long long)result->matches, result->seconds, result->threads,
+            rate / 1e6, rate / 1e6 / result->threads, (unsigned long long)result->steals);
+}
+
+void tournament_result_free(TournamentResult *result) {
+    free(result->pairs);
+    result->pairs = NULL;
+}
@@ -0,0 +1,43 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Parallel round-robin tournament (GTK-free)
+ * ----------------------------------------------------------------------------
+ * NOTE: Every pair of strategies plays matches_per_pair matches. The work is
+ * cut into chunks and spread over per-worker deques; idle workers steal
+ * from the others. Each worker keeps its own MatchStats per pairing and the
+ * totals are merged only after all workers have joined, so the hot path
+ * never touches shared counters.
+ */
+
+#ifndef RPS_TOURNAMENT_H
+#define RPS_TOURNAMENT_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "engine.h"
+
+typedef struct {
+    const char *const *names;   /* strategy registry names (see strategy.h) */
+    int n_strategies;
+    uint64_t matches_per_pair;
+    uint64_t chunk_matches;     /* matches per work item, 0 = default */
+    int threads;                /* 0 = one per online core */
+    uint64_t seed;
+} TournamentConfig;
+
+typedef struct {
+    int n_strategies;
+    MatchStats *pairs;          /* [i * n + j] for i < j: i plays side "a" */
+    uint64_t matches;
+    uint64_t steals;            /* work items taken from another worker */
+    int threads;
+    double seconds;
+} TournamentResult;
+
+/* Returns 0 on success, -1 on bad config / unknown strategy / allocation failure */
+int tournament_run(const TournamentConfig *config, TournamentResult *result);
+void tournament_print(const TournamentResult *result, const char *const *names, FILE *out);
+void tournament_result_free(TournamentResult *result);
+
+#endif /* RPS_TOURNAMENT_H */
@@ -0,0 +1,188 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Input-to-display latency tracing
+ * ----------------------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "histogram.h"
+#include "trace.h"
+
+#define OVERLAY_REFRESH_MS 500
+#define MAX_FRAME_GAP_US G_USEC_PER_SEC
+
+gboolean trace_enabled = FALSE;
+
+static const char *const span_names[TRACE_SPAN_COUNT] = {
+    "input -> callback",
+    "input -> paint",
+    "last click -> result",
+    "frame update+layout",
+    "frame paint",
+    "frame interval",
+};
+
+typedef struct {
+    Histogram spans[TRACE_SPAN_COUNT];
+    char *path;                 /* NULL: stderr */
+    GtkWidget *overlay_label;
+    guint overlay_timer;
+    GdkFrameClock *clock;
+
+    gint64 input_us;            /* last click; 0 once its paint was recorded */
+    gint64 round_click_us;      /* last click; 0 once its round was scored */
+    gint64 result_click_us;     /* click that ended the match; 0 when none pending */
+    GtkStack *result_stack;     /* set once the result screen was requested */
+    gint64 frame_begin_us;
+    gint64 layout_done_us;
+    gint64 last_paint_us;
+} Tracer;
+
+static Tracer *tracer;
+
+static void trace_record(TraceSpan span, gint64 us) {
+    if (us >= 0) hist_record(&tracer->spans[span], (uint64_t)us);
+}
+
+/* --- Hooks --- */
+void trace_input_real(void) {
+    tracer->input_us = tracer->round_click_us = g_get_monotonic_time();
+}
+
+void trace_callback_done_real(void) {
+    if (tracer->round_click_us) trace_record(TRACE_INPUT_TO_CALLBACK, g_get_monotonic_time() - tracer->round_click_us);
+    tracer->round_click_us = 0;
+}
+
+void trace_result_pending_real(void) {
+    tracer->result_click_us = tracer->round_click_us;
+    tracer->result_stack = NULL;
+}
+
+void trace_result_shown_real(GtkStack *stack) {
+    if (tracer->result_click_us) tracer->result_stack = stack;
+}
+
+/* --- Frame clock phases; ours run after GTK's own handlers for each phase --- */
+static void on_before_paint(GdkFrameClock *clock, gpointer user_data) {
+    (void)clock; (void)user_data;
+    tracer->frame_begin_us = g_get_monotonic_time();
+}
+
+static void on_layout(GdkFrameClock *clock, gpointer user_data) {
+    (void)clock; (void)user_data;
+    tracer->layout_done_us = g_get_monotonic_time();
+    if (tracer->frame_begin_us) trace_record(TRACE_FRAME_LAYOUT, tracer->layout_done_us - tracer->frame_begin_us);
+}
+
+static void on_after_paint(GdkFrameClock *clock, gpointer user_data) {
+    gint64 now = g_get_monotonic_time();
+    (void)clock; (void)user_data;
+
+    if (tracer->layout_done_us) trace_record(TRACE_FRAME_PAINT, now - tracer->layout_done_us);
+    if (tracer->last_paint_us && now - tracer->last_paint_us < MAX_FRAME_GAP_US)
+        trace_record(TRACE_FRAME_INTERVAL, now - tracer->last_paint_us);
+    tracer->last_paint_us = now;
+    tracer->frame_begin_us = tracer->layout_done_us = 0;
+
+    if (tracer->input_us) {
+        trace_record(TRACE_INPUT_TO_PAINT, now - tracer->input_us);
+        tracer->input_us = 0;
+    }
+    if (tracer->result_stack && !gtk_stack_get_transition_running(tracer->result_stack)) {
+        trace_record(TRACE_CLICK_TO_RESULT, now - tracer->result_click_us);
+        tracer->result_click_us = 0;
+        tracer->result_stack = NULL;
+    }
+}
+
+/* --- Output --- */
+static void trace_report(FILE *out) {
+    fprintf(out, "latency trace (microseconds)\n");
+    for (int i = 0; i < TRACE_SPAN_COUNT; i++) {
+        if (tracer->spans[i].total) hist_print(&tracer->spans[i], span_names[i], "us", 1.0, out);
+        else fprintf(out, "%-22s no samples\n", span_names[i]);
+    }
+}
+
+static gboolean on_overlay_refresh(gpointer user_data) {
+    GString *text = g_string_new(NULL);
+    (void)user_data;
+
+    for (int i = 0; i < TRACE_SPAN_COUNT; i++) {
+        const Histogram *h = &tracer->spans[i];
+        if (!h->total) continue;
+        g_string_append_printf(text, "%s%s  p50 %.1f ms  p99 %.1f ms", text->len ? "\n" : "", span_names[i],
+                               hist_percentile(h, 50.0) / 1000.0, hist_percentile(h, 99.0) / 1000.0);
+    }
+    gtk_label_set_text(GTK_LABEL(tracer->overlay_label), text->len ? text->str : "trace: waiting for input");
+    g_string_free(text, TRUE);
+    return G_SOURCE_CONTINUE;
+}
+
+/* --- Lifecycle --- */
+static void trace_setup(void) {
+    const char *mode = g_getenv("RPS_TRACE");
+
+    if (tracer || !mode || !*mode || strcmp(mode, "0") == 0) return;
+    tracer = g_new0(Tracer, 1);
+    for (int i = 0; i < TRACE_SPAN_COUNT; i++) hist_init(&tracer->spans[i]);
+    if (strcmp(mode, "1") != 0 && strcmp(mode, "stderr") != 0 && strcmp(mode, "overlay") != 0)
+        tracer->path = g_strdup(mode);
+    trace_enabled = TRUE;
+}
+
+GtkWidget *trace_wrap(GtkWidget *child) {
+    const char *mode = g_getenv("RPS_TRACE");
+    GtkWidget *overlay;
+
+    trace_setup();
+    if (!trace_enabled || g_strcmp0(mode, "overlay") != 0) return child;
+
+    overlay = gtk_overlay_new();
+    gtk_overlay_set_child(GTK_OVERLAY(overlay), child);
+    tracer->overlay_label = gtk_label_new("trace: waiting for input");
+    gtk_widget_add_css_class(tracer->overlay_label, "trace-overlay");
+    gtk_widget_set_halign(tracer->overlay_label, GTK_ALIGN_END);
+    gtk_widget_set_valign(tracer->overlay_label, GTK_ALIGN_START);
+    gtk_widget_set_can_target(tracer->overlay_label, FALSE); /* clicks go through */
+    gtk_overlay_add_overlay(GTK_OVERLAY(overlay), tracer->overlay_label);
+    tracer->overlay_timer = g_timeout_add(OVERLAY_REFRESH_MS, on_overlay_refresh, NULL);
+    return overlay;
+}
+
+void trace_init(GtkWidget *window) {
+    trace_setup();
+    if (!trace_enabled || tracer->clock) return;
+    tracer->clock = gtk_widget_get_frame_clock(window);
+    if (!tracer->clock) return;
+    g_object_ref(tracer->clock);
+    g_signal_connect(tracer->clock, "before-paint", G_CALLBACK(on_before_paint), NULL);
+    g_signal_connect(tracer->clock, "layout", G_CALLBACK(on_layout), NULL);
+    g_signal_connect(tracer->clock, "after-paint", G_CALLBACK(on_after_paint), NULL);
+}
+
+void trace_finish(void) {
+    FILE *out = stderr;
+
+    if (!tracer) return;
+    trace_enabled = FALSE;
+    if (tracer->overlay_timer) g_source_remove(tracer->overlay_timer);
+    if (tracer->clock) {
+        g_signal_handlers_disconnect_by_func(tracer->clock, G_CALLBACK(on_before_paint), NULL);
+        g_signal_handlers_disconnect_by_func(tracer->clock, G_CALLBACK(on_layout), NULL);
+        g_signal_handlers_disconnect_by_func(tracer->clock, G_CALLBACK(on_after_paint), NULL);
+        g_object_unref(tracer->clock);
+    }
+    if (tracer->path && !(out = fopen(tracer->path, "w"))) {
+        g_printerr("trace: cannot write %s, using stderr\n", tracer->path);
+        out = stderr;
+    }
+    trace_report(out);
+    if (out != stderr) fclose(out);
+    g_free(tracer->path);
+    g_free(tracer);
+    tracer = NULL;
+}
@@ -0,0 +1,64 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: Input-to-display latency tracing
+ * ----------------------------------------------------------------------------
+ * NOTE: Off unless RPS_TRACE is set; then the hooks below are one
+ * predictable branch each. RPS_TRACE values:
+ *   1 / stderr     histograms printed to stderr when the window closes
+ *   overlay        live p50/p99 in a corner of the window, plus stderr
+ *   <path>         histograms written to that file when the window closes
+ *
+ * Spans are measured with g_get_monotonic_time() (microseconds):
+ *   input -> callback     choice click until the callback that scores its
+ *                         round returned (the computer's move is worked
+ *                         out on another thread in between; a cancelled
+ *                         round records nothing)
+ *   input -> paint        choice click until the next frame was painted
+ *   last click -> result  final round's click until the result screen is
+ *                         painted with the stack transition finished
+ *                         (includes the RPS_RESULTS_DELAY_MS pause)
+ *   frame update+layout   frame-clock before-paint until layout is done
+ *   frame paint           layout done until snapshot + render are done
+ *   frame interval        between painted frames (gaps over 1 s skipped)
+ */
+
+#ifndef RPS_TRACE_H
+#define RPS_TRACE_H
+
+#include <gtk/gtk.h>
+
+typedef enum {
+    TRACE_INPUT_TO_CALLBACK,
+    TRACE_INPUT_TO_PAINT,
+    TRACE_CLICK_TO_RESULT,
+    TRACE_FRAME_LAYOUT,
+    TRACE_FRAME_PAINT,
+    TRACE_FRAME_INTERVAL,
+    TRACE_SPAN_COUNT
+} TraceSpan;
+
+extern gboolean trace_enabled;
+
+/* Reads RPS_TRACE; call once the window has been presented */
+void trace_init(GtkWidget *window);
+/* `child` wrapped in an overlay for RPS_TRACE=overlay, else `child` itself */
+GtkWidget *trace_wrap(GtkWidget *child);
+/* Writes the report and releases everything */
+void trace_finish(void);
+
+void trace_input_real(void);
+void trace_callback_done_real(void);
+void trace_result_pending_real(void);
+void trace_result_shown_real(GtkStack *stack);
+
+/* A choice button was clicked */
+#define TRACE_INPUT() do { if (G_UNLIKELY(trace_enabled)) trace_input_real(); } while (0)
+/* The clicked round was scored and shown; its callback is about to return */
+#define TRACE_CALLBACK_DONE() do { if (G_UNLIKELY(trace_enabled)) trace_callback_done_real(); } while (0)
+/* The last click ended the match; the result screen is on its way */
+#define TRACE_RESULT_PENDING() do { if (G_UNLIKELY(trace_enabled)) trace_result_pending_real(); } while (0)
+/* The result screen was made visible child of `stack` */
+#define TRACE_RESULT_SHOWN(stack) do { if (G_UNLIKELY(trace_enabled)) trace_result_shown_real(stack); } while (0)
+
+#endif /* RPS_TRACE_H */
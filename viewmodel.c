@@ -0,0 +1,145 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: View-model diff layer
+ * ----------------------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "viewmodel.h"
+
+static const char *const STATE_CLASSES[] = { NULL, "success", "error", "warning", "busy" };
+
+/* --- Scheduling --- */
+static gboolean on_vm_tick(GtkWidget *widget, GdkFrameClock *clock, gpointer user_data) {
+    ViewModel *vm = user_data;
+    (void)widget;
+    (void)clock;
+
+    vm->tick_id = 0;
+    vm_flush(vm);
+    return G_SOURCE_REMOVE; /* re-armed by the next setter that changes something */
+}
+
+static void vm_schedule(ViewModel *vm, VmSlot *s) {
+    s->dirty = TRUE;
+    if (vm->tick_id == 0 && vm->tick_widget)
+        vm->tick_id = gtk_widget_add_tick_callback(vm->tick_widget, on_vm_tick, vm, NULL);
+}
+
+/* --- Setup --- */
+void vm_init(ViewModel *vm, GtkWidget *tick_widget) {
+    memset(vm, 0, sizeof(*vm));
+    vm->tick_widget = tick_widget;
+}
+
+/* Attach a widget to a slot. The widget's current state becomes "have";
+ * anything written to the slot before the screen existed stays pending and
+ * goes out with the next flush. */
+void vm_bind(ViewModel *vm, int slot, GtkWidget *widget, VmKind kind) {
+    VmSlot *s = &vm->slots[slot];
+    const char *text = NULL;
+
+    s->widget = widget;
+    s->kind = kind;
+    if (kind == VM_KIND_LABEL) text = gtk_label_get_text(GTK_LABEL(widget));
+    else if (kind == VM_KIND_BUTTON) text = gtk_button_get_label(GTK_BUTTON(widget));
+    g_strlcpy(s->have_text, text ? text : "", sizeof(s->have_text));
+    s->have_visible = gtk_widget_get_visible(widget);
+    s->have_state = VM_STATE_NONE;
+
+    if (!s->dirty) {
+        memcpy(s->want_text, s->have_text, sizeof(s->want_text));
+        s->want_visible = s->have_visible;
+        s->want_state = s->have_state;
+    } else {
+        vm_schedule(vm, s);
+    }
+}
+
+/* --- Setters --- */
+void vm_set_text(ViewModel *vm, int slot, const char *text) {
+    VmSlot *s = &vm->slots[slot];
+
+    vm->requested++;
+    if (strncmp(s->want_text, text, sizeof(s->want_text)) == 0) return;
+    g_strlcpy(s->want_text, text, sizeof(s->want_text));
+    vm_schedule(vm, s);
+}
+
+/* Format straight into a stack buffer: no g_strdup_printf per update */
+void vm_set_textf(ViewModel *vm, int slot, const char *format, ...) {
+    char buf[VM_TEXT_MAX];
+    va_list args;
+
+    va_start(args, format);
+    g_vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    vm_set_text(vm, slot, buf);
+}
+
+void vm_set_state(ViewModel *vm, int slot, VmState state) {
+    VmSlot *s = &vm->slots[slot];
+
+    vm->requested++;
+    if (s->want_state == state) return;
+    s->want_state = state;
+    vm_schedule(vm, s);
+}
+
+void vm_set_visible(ViewModel *vm, int slot, gboolean visible) {
+    VmSlot *s = &vm->slots[slot];
+
+    vm->requested++;
+    visible = visible ? TRUE : FALSE;
+    if (s->want_visible == visible) return;
+    s->want_visible = visible;
+    vm_schedule(vm, s);
+}
+
+/* --- Flush --- */
+/* Push the differences between "want" and "have" to GTK. Called from the
+ * frame-clock tick, or directly when a caller needs the widgets current. */
+void vm_flush(ViewModel *vm) {
+    if (vm->tick_id) {
+        gtk_widget_remove_tick_callback(vm->tick_widget, vm->tick_id);
+        vm->tick_id = 0;
+    }
+    vm->frames++;
+
+    for (int i = 0; i < VM_MAX_SLOTS; i++) {
+        VmSlot *s = &vm->slots[i];
+        if (!s->dirty || !s->widget) continue;
+        s->dirty = FALSE;
+
+        if (s->kind != VM_KIND_WIDGET && strcmp(s->want_text, s->have_text) != 0) {
+            if (s->kind == VM_KIND_LABEL) gtk_label_set_text(GTK_LABEL(s->widget), s->want_text);
+            else gtk_button_set_label(GTK_BUTTON(s->widget), s->want_text);
+            memcpy(s->have_text, s->want_text, sizeof(s->have_text));
+            vm->applied++;
+        }
+        if (s->want_state != s->have_state) {
+            /* one remove + one add instead of clearing every class */
+            if (STATE_CLASSES[s->have_state]) gtk_widget_remove_css_class(s->widget, STATE_CLASSES[s->have_state]);
+            if (STATE_CLASSES[s->want_state]) gtk_widget_add_css_class(s->widget, STATE_CLASSES[s->want_state]);
+            if ((s->have_state == VM_STATE_BUSY) != (s->want_state == VM_STATE_BUSY))
+                gtk_widget_set_sensitive(s->widget, s->want_state != VM_STATE_BUSY);
+            s->have_state = s->want_state;
+            vm->applied++;
+        }
+        if (s->want_visible != s->have_visible) {
+            gtk_widget_set_visible(s->widget, s->want_visible);
+            s->have_visible = s->want_visible;
+            vm->applied++;
+        }
+    }
+}
+
+void vm_print_stats(const ViewModel *vm, FILE *out) {
+    guint64 skipped = vm->requested > vm->applied ? vm->requested - vm->applied : 0;
+    fprintf(out, "view-model: %" G_GUINT64_FORMAT " updates requested, %" G_GUINT64_FORMAT
+            " applied, %" G_GUINT64_FORMAT " skipped (%.1f%%) over %" G_GUINT64_FORMAT " flushes\n",
+            vm->requested, vm->applied, skipped,
+            vm->requested ? 100.0 * (double)skipped / (double)vm->requested : 0.0, vm->frames);
+}
@@ -0,0 +1,74 @@
+/*
+ * ----------------------------------------------------------------------------
+ * Project: Rock Paper Scissors (GTK4)
+ * Module: View-model diff layer
+ * ----------------------------------------------------------------------------
+ * NOTE: Game code writes the desired label text, result styling and
+ * visibility into numbered slots. Nothing touches GTK until the next
+ * frame-clock tick, when only the fields that really changed are pushed to
+ * the widgets. Repeated or no-op writes between two frames cost a memcmp.
+ */
+
+#ifndef RPS_VIEWMODEL_H
+#define RPS_VIEWMODEL_H
+
+#include <gtk/gtk.h>
+
+#define VM_MAX_SLOTS 16
+#define VM_TEXT_MAX 256
+
+/* Result styling; maps to the "success"/"error"/"warning" CSS classes.
+ * VM_STATE_BUSY ("busy") also makes the widget insensitive until the
+ * state changes again. */
+typedef enum {
+    VM_STATE_NONE = 0,
+    VM_STATE_SUCCESS,
+    VM_STATE_ERROR,
+    VM_STATE_WARNING,
+    VM_STATE_BUSY
+} VmState;
+
+typedef enum {
+    VM_KIND_LABEL = 0,   /* text via gtk_label_set_text() */
+    VM_KIND_BUTTON,      /* text via gtk_button_set_label() */
+    VM_KIND_WIDGET       /* visibility/state only */
+} VmKind;
+
+typedef struct {
+    GtkWidget *widget;           /* NULL until the screen is built */
+    VmKind kind;
+    gboolean dirty;
+    /* desired state */
+    char want_text[VM_TEXT_MAX];
+    VmState want_state;
+    gboolean want_visible;
+    /* what the widget currently shows */
+    char have_text[VM_TEXT_MAX];
+    VmState have_state;
+    gboolean have_visible;
+} VmSlot;
+
+typedef struct {
+    VmSlot slots[VM_MAX_SLOTS];
+    GtkWidget *tick_widget;      /* widget whose frame clock drives flushes */
+    guint tick_id;
+    /* counters: every setter call is a request; a request that changes
+     * nothing on screen (same value, or overwritten before the frame) is
+     * skipped, only real differences are applied */
+    guint64 requested;
+    guint64 applied;
+    guint64 frames;
+} ViewModel;
+
+void vm_init(ViewModel *vm, GtkWidget *tick_widget);
+void vm_bind(ViewModel *vm, int slot, GtkWidget *widget, VmKind kind);
+
+void vm_set_text(ViewModel *vm, int slot, const char *text);
+void vm_set_textf(ViewModel *vm, int slot, const char *format, ...) G_GNUC_PRINTF(3, 4);
+void vm_set_state(ViewModel *vm, int slot, VmState state);
+void vm_set_visible(ViewModel *vm, int slot, gboolean visible);
+
+void vm_flush(ViewModel *vm);
+void vm_print_stats(const ViewModel *vm, FILE *out);
+
+#endif /* RPS_VIEWMODEL_H */